@@ -57,7 +57,7 @@ int _atoi(char *s)
  */
 int interactive(info_t *info)
 {
-	return (isatty(STDIN_FILENO) && info->readfd <= 2);
+	return (!info->src && isatty(STDIN_FILENO) && info->readfd <= 2);
 }
 
 
@@ -17,27 +17,18 @@ int _myhistory(info_t *info)
 /**
  * unset_alias - deletes an alias from the list of aliases
  * @info: structure containing shell state, including the alias list
- * @str: string that represents the alias to be removed
+ * @str: string that represents the alias to be removed, name=
  *
- * Separates the alias name from its value and removes the alias
- * from the list if found.
  * Return: 0 on successful removal, 1 if the alias was not found
  * or if an error occurred.
  */
 int unset_alias(info_t *info, char *str)
 {
-	char *p, c;
-	int ret;
+	char *p = _strchr(str, '=');
 
-	p = _strchr(str, '=');
 	if (!p)
 		return (1);
-	c = *p;
-	*p = 0;
-	ret = delete_node_at_index(&(info->alias),
-		get_node_index(info->alias, node_starts_with(info->alias, str, -1)));
-	*p = c;
-	return (ret);
+	return (alias_remove(info, str, p - str));
 }
 
 /**
@@ -45,59 +36,77 @@ int unset_alias(info_t *info, char *str)
  * @info: structure containing shell state, including the alias list
  * @str: string that represents the alias and its value
  *
- * Analyzes the given string and either creates a new alias
- * or updates an existing one.
+ * An alias set to nothing is deleted. One whose value leaves a quote or
+ * substitution open is not defined, since it could never be run, nor
+ * one with an operator in it: the value only ever stands for the words
+ * of a simple command.
  * Return: 0 on success, 1 on failure to set the alias.
  */
 int set_alias(info_t *info, char *str)
 {
+	token_t *toks;
+	int ntok, i;
 	char *p;
 
 	p = _strchr(str, '=');
-	if (!p)
+	if (!p || p == str)
 		return (1);
-	if (!*++p)
-		return (set_alias(info, str));
-
-	set_alias(info, str);
-	return (add_node_end(&(info->alias), str, 0) == NULL);
+	if (!p[1])
+		return (unset_alias(info, str));
+	toks = lex_copy(info, p + 1, &ntok);
+	if (ntok == LEX_OPEN)
+	{
+		print_error(info, str);
+		_eputs(": quote or substitution left open\n");
+	}
+	if (ntok < 0)
+		return (1);
+	for (i = 0; i < ntok && toks[i].type == TOK_WORD; i++)
+		;
+	if (i < ntok)
+	{
+		print_error(info, str);
+		_eputs(": operator in an alias\n");
+		return (free(toks), 1);
+	}
+	return (alias_store(info, str, toks, ntok) == -1);
 }
 
 /**
  * _myalias - mimics the alias builtin (man alias)
  * @info: Structure containing potential arguments. Used to maintain
  *          constant function prototype.
- *  Return: Always 0
+ * The status is the same as the return value.
+ *  Return: 0, 1 if an alias to print does not exist or one could not
+ *  be set
  */
 int _myalias(info_t *info)
 {
-	int i = 0;
-	char *p = NULL;
-	list_t *node = NULL;
+	int i, ret = 0;
+	list_t *node;
+	alias_t *a;
 
+	info->status = 0;
 	if (info->argc == 1)
 	{
-		node = info->alias;
-		while (node)
-		{
-			print_list(node);
-			node = node->next;
-		}
+		for (node = info->alias; node; node = node->next)
+			print_alias(node);
 		return (0);
 	}
 	for (i = 1; info->argv[i]; i++)
 	{
-		p = _strchr(info->argv[i], '=');
-		if (p)
-			set_alias(info, info->argv[i]);
+		if (_strchr(info->argv[i], '='))
+			ret |= set_alias(info, info->argv[i]);
+		else if ((a = alias_find(info, info->argv[i],
+			_strlen(info->argv[i]))))
+			print_alias(a->node);
 		else
-			print_list(node_starts_with(info->alias, info->argv[i], '='));
+			ret = 1;
 	}
-
-	return (0);
+	info->status = ret;
+	return (ret);
 }
 
-
 /**
  * print_alias - prints an alias string
  * @node: the alias node
@@ -0,0 +1,138 @@
+#include "shell.h"
+
+/**
+ * alias_key - hashes an alias name into a bucket index
+ * @name: the name, which need not be null-terminated
+ * @n: the length of the name
+ *
+ * Return: the bucket index, below ALIAS_HASH_SIZE
+ */
+static unsigned int alias_key(char *name, size_t n)
+{
+	unsigned int h = 5381;
+
+	while (n--)
+		h = h * 33 + (unsigned char)*name++;
+	return (h % ALIAS_HASH_SIZE);
+}
+
+/**
+ * alias_find - looks up an alias
+ * @info: the info struct holding shell context
+ * @name: the name, which need not be null-terminated
+ * @n: the length of the name
+ *
+ * Return: the alias table entry, or NULL if there is no such alias
+ */
+alias_t *alias_find(info_t *info, char *name, size_t n)
+{
+	alias_t *a;
+
+	if (!info->alias_hash)
+		return (NULL);
+	for (a = info->alias_hash[alias_key(name, n)]; a; a = a->next)
+		if (a->nlen == n && !strncmp(a->node->str, name, n))
+			return (a);
+	return (NULL);
+}
+
+/**
+ * alias_store - defines an alias, or changes its value
+ * @info: the info struct holding shell context
+ * @str: the definition, name=value
+ * @toks: the tokens of the value, lexed by the caller, which the table
+ * takes over
+ * @ntok: the number of tokens
+ *
+ * A new alias goes at the end of info->alias, so they are listed in
+ * the order they were defined; a redefined one keeps its place. The
+ * value is lexed once, when it is set, so expanding the alias never
+ * lexes again. Token offsets are relative to the value, so tokens
+ * lexed from @str hold for the copy of it kept here.
+ * Return: 0 on success, -1 if memory ran out, @toks then being freed
+ */
+int alias_store(info_t *info, char *str, token_t *toks, int ntok)
+{
+	size_t n = _strchr(str, '=') - str;
+	alias_t *a = alias_find(info, str, n);
+	char *s = a ? _strdup(str) : NULL;
+
+	if (a && !s)
+		return (free(toks), -1);
+	if (a)
+	{
+		free(a->node->str);
+		a->node->str = s;
+	}
+	else if (!info->alias_hash)
+	{
+		info->alias_hash = malloc(sizeof(alias_t *) * ALIAS_HASH_SIZE);
+		if (!info->alias_hash)
+			return (free(toks), -1);
+		_memset((void *)info->alias_hash, 0,
+			sizeof(alias_t *) * ALIAS_HASH_SIZE);
+	}
+	if (!a)
+	{
+		a = malloc(sizeof(alias_t));
+		if (!a)
+			return (free(toks), -1);
+		_memset((void *)a, 0, sizeof(alias_t));
+		a->node = add_node_end(&(info->alias), str, 0);
+		if (!a->node)
+			return (free(a), free(toks), -1);
+		a->nlen = n;
+		a->next = info->alias_hash[alias_key(str, n)];
+		info->alias_hash[alias_key(str, n)] = a;
+	}
+	free(a->toks);
+	a->toks = toks;
+	a->ntok = ntok;
+	return (0);
+}
+
+/**
+ * alias_remove - deletes an alias
+ * @info: the info struct holding shell context
+ * @name: the name, which need not be null-terminated
+ * @n: the length of the name
+ *
+ * Return: 0 if the alias was deleted, 1 if there was no such alias
+ */
+int alias_remove(info_t *info, char *name, size_t n)
+{
+	alias_t **p, *a = alias_find(info, name, n);
+
+	if (!a)
+		return (1);
+	p = &info->alias_hash[alias_key(name, n)];
+	while (*p != a)
+		p = &(*p)->next;
+	*p = a->next;
+	delete_node_at_index(&info->alias,
+		get_node_index(info->alias, a->node));
+	free(a->toks);
+	free(a);
+	return (0);
+}
+
+/**
+ * alias_clear - frees the alias table
+ * @info: the info struct holding shell context
+ *
+ * Only the index goes; the caller frees info->alias itself.
+ */
+void alias_clear(info_t *info)
+{
+	alias_t *a, *next;
+	int i;
+
+	for (i = 0; info->alias_hash && i < ALIAS_HASH_SIZE; i++)
+		for (a = info->alias_hash[i]; a; a = next)
+		{
+			next = a->next;
+			free(a->toks);
+			free(a);
+		}
+	bfree((void **)&info->alias_hash);
+}
@@ -0,0 +1,111 @@
+#include "shell.h"
+
+/**
+ * arena_alloc - hands out memory from the per-command arena
+ * @info: the shell state structure, owner of the arena
+ * @n: the number of bytes wanted
+ *
+ * Memory is bumped off the newest block, and a new block at least
+ * ARENA_BLOCK bytes large is started when it does not fit. Nothing is
+ * freed on its own: arena_reset() releases everything at once.
+ * Return: the memory, aligned for pointers, or NULL if memory ran out
+ */
+void *arena_alloc(info_t *info, size_t n)
+{
+	arenablk_t *b = info->arena;
+	size_t size;
+
+	n = (n + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+	if (!b || b->size - b->used < n)
+	{
+		size = n > ARENA_BLOCK ? n : ARENA_BLOCK;
+		b = malloc(sizeof(*b) + size);
+		if (!b)
+			return (NULL);
+		b->next = info->arena;
+		b->size = size;
+		b->used = 0;
+		info->arena = b;
+	}
+	b->used += n;
+	return ((char *)(b + 1) + b->used - n);
+}
+
+/**
+ * arena_dup - copies a string into the arena
+ * @info: the shell state structure
+ * @s: the string
+ *
+ * Return: the copy, or NULL if memory ran out
+ */
+char *arena_dup(info_t *info, char *s)
+{
+	size_t n = _strlen(s) + 1;
+	char *p = arena_alloc(info, n);
+
+	if (p)
+		memcpy(p, s, n);
+	return (p);
+}
+
+/**
+ * replace_arg - substitutes a string for one of the command's words
+ * @info: the shell state structure
+ * @i: the index of the word in info->argv
+ * @s: the new word, copied into the arena
+ *
+ * Return: 1 to indicate the operation was successful, 0 if memory ran out
+ */
+int replace_arg(info_t *info, int i, char *s)
+{
+	char *p = arena_dup(info, s);
+
+	if (!p)
+		return (0);
+	info->argv[i] = p;
+	return (1);
+}
+
+/**
+ * arena_reset - releases everything handed out by the arena
+ * @info: the shell state structure
+ *
+ * The largest block is kept for the next command, so a shell running
+ * commands of similar size settles on a single block and no mallocs.
+ */
+void arena_reset(info_t *info)
+{
+	arenablk_t *b = info->arena, *keep = b, *next;
+
+	for (; b; b = b->next)
+		if (b->size > keep->size)
+			keep = b;
+	for (b = info->arena; b; b = next)
+	{
+		next = b->next;
+		if (b != keep)
+			free(b);
+	}
+	if (keep)
+	{
+		keep->next = NULL;
+		keep->used = 0;
+	}
+	info->arena = keep;
+}
+
+/**
+ * arena_free - frees the arena entirely
+ * @info: the shell state structure
+ */
+void arena_free(info_t *info)
+{
+	arenablk_t *b, *next;
+
+	for (b = info->arena; b; b = next)
+	{
+		next = b->next;
+		free(b);
+	}
+	info->arena = NULL;
+}
@@ -0,0 +1,106 @@
+#include "shell.h"
+
+/**
+ * arith_error - says what is wrong with an arithmetic expression
+ * @info: the shell state structure
+ * @msg: what is wrong
+ * @text: the expression, or the value that is no number
+ * @len: its length
+ */
+void arith_error(info_t *info, char *msg, char *text, size_t len)
+{
+	size_t i;
+
+	info->line_count += info->linecount_flag == 1;
+	info->linecount_flag = 0;
+	_eputs(info->fname);
+	_eputs(": ");
+	print_d(info->line_count, STDERR_FILENO);
+	_eputs(": arithmetic expression: ");
+	_eputs(msg);
+	_eputs(": \"");
+	for (i = 0; i < len; i++)
+		_eputchar(text[i]);
+	_eputs("\"\n");
+}
+
+/**
+ * arith_subst - expands an arithmetic expansion into xbuf
+ * @info: the shell state structure
+ * @s: the first ( of a $((...))
+ * @dq: on if the expansion is inside double quotes
+ *
+ * A $(( that is not closed by a matching )) is a command substitution
+ * of a subshell, and goes to cmd_subst(). Text with nothing to expand
+ * is evaluated as it stands in the line, and so is cached; anything
+ * else is expanded first, as if in double quotes, and compiled afresh.
+ * Return: the text after the expansion, NULL on an error, after saying
+ * what it was, or if memory ran out
+ */
+char *arith_subst(info_t *info, char *s, int dq)
+{
+	char *end = subst_end(s), *text = s + 2, *p = text;
+	size_t mark = info->xlen, len;
+	long v;
+
+	if (!end || end[-1] != ')' || subst_end(s + 1) != end - 1)
+		return (cmd_subst(info, s, dq));
+	while (p < end - 1 && !_strchr("$`'\"\\", *p))
+		p++;
+	len = end - 1 - text;
+	if (p < end - 1)
+	{
+		if (expand_text(info, text, end - 1, 1))
+			return (NULL);
+		text = info->xbuf + mark;
+		len = info->xlen - mark;
+	}
+	info->xlen = mark;
+	if (arith_eval(info, text, len, p == end - 1, &v))
+		return (NULL);
+	p = convert_number(v, 10, 0);
+	return (xbuf_put(info, p, _strlen(p)) ? NULL : end + 1);
+}
+
+/**
+ * _mylet - evaluates arithmetic expressions, as let and arith
+ * @info: the shell state, whose arguments are the expressions
+ *
+ * Each argument is one expression, evaluated from left to right. The
+ * status is 0 if the last one is not 0, 1 if it is, 2 on an error.
+ * Return: Always 0
+ */
+int _mylet(info_t *info)
+{
+	long v = 0;
+	int i;
+
+	info->status = 2;
+	if (info->argc < 2)
+		return (print_error(info, "expression expected\n"), 0);
+	for (i = 1; i < info->argc; i++)
+		if (arith_eval(info, info->argv[i], _strlen(info->argv[i]), 1,
+			&v))
+			return (0);
+	info->status = !v;
+	return (0);
+}
+
+/**
+ * arith_clear - drops every compiled arithmetic expression
+ * @info: the shell state structure
+ */
+void arith_clear(info_t *info)
+{
+	arith_t *p, *next;
+	int i;
+
+	for (i = 0; info->arith_hash && i < ARITH_HASH_SIZE; i++)
+		for (p = info->arith_hash[i]; p; p = next)
+		{
+			next = p->next;
+			free(p);
+		}
+	bfree((void **)&info->arith_hash);
+	info->arith_count = 0;
+}
@@ -0,0 +1,157 @@
+#include "shell.h"
+
+/*
+ * The precedence of each binary op, from A_MUL to A_LOR; the higher,
+ * the tighter it binds, as in C.
+ */
+static const unsigned char arith_prec[] = {
+	10, 10, 10, 9, 9, 8, 8, 7, 7, 7, 7, 6, 6, 5, 4, 3, 2, 1
+};
+
+/**
+ * arith_emit - appends an op to the expression being compiled
+ * @c: the compiler state
+ * @op: the A_ op
+ * @val: its value
+ *
+ * c->ops has room for two ops per byte of text, more than any text
+ * can give, so nothing is ever checked.
+ * Return: the index of the op, to patch jumps with
+ */
+static int arith_emit(arithc_t *c, int op, long val)
+{
+	c->ops[c->nops].op = op;
+	c->ops[c->nops].val = val;
+	return (c->nops++);
+}
+
+/**
+ * arith_unary - compiles an operand with its unary operators
+ * @c: the compiler state, at the operand's first token
+ *
+ * An operand is a number, a variable, or an expression in parentheses.
+ */
+static void arith_unary(arithc_t *c)
+{
+	int op = c->tok;
+
+	if (op == A_ADD || op == A_SUB || op == A_NOT || op == A_INV)
+	{
+		arith_next(c);
+		arith_unary(c);
+		if (op != A_ADD)
+			arith_emit(c, op == A_SUB ? A_NEG : op, 0);
+		return;
+	}
+	if (op == A_NUM || op == A_VAR)
+		arith_emit(c, op, c->num);
+	else if (op == A_LPAREN)
+	{
+		arith_next(c);
+		arith_expr(c);
+		if (c->tok != A_RPAREN && !c->err)
+			c->err = "missing )";
+	}
+	else if (!c->err)
+		c->err = "expecting operand";
+	arith_next(c);
+}
+
+/**
+ * arith_binary - compiles binary operators of a precedence and up
+ * @c: the compiler state
+ * @min: the lowest precedence to take in
+ *
+ * Precedence climbing: each operator compiles its right side with the
+ * operators that bind tighter, so a op goes after both its operands.
+ * Once the left side of && or || decides the result, the right side
+ * is jumped over to the A_BOOL that makes either side 0 or 1.
+ */
+static void arith_binary(arithc_t *c, int min)
+{
+	int op, j;
+
+	arith_unary(c);
+	while (IS_ABINARY(c->tok) && arith_prec[c->tok - A_MUL] >= min)
+	{
+		op = c->tok;
+		j = -1;
+		if (op == A_LAND || op == A_LOR)
+			j = arith_emit(c, op == A_LAND ? A_ANDJ : A_ORJ, 0);
+		arith_next(c);
+		arith_binary(c, arith_prec[op - A_MUL] + 1);
+		if (j == -1)
+			arith_emit(c, op, 0);
+		else
+			c->ops[j].val = arith_emit(c, A_BOOL, 0);
+	}
+}
+
+/**
+ * arith_assign - compiles an assignment or a conditional expression
+ * @c: the compiler state
+ *
+ * A name followed by = or op= is assigned the value on its right, which
+ * groups from the right; anything else is read as a conditional, whose
+ * branches are jumped between so only one of them is evaluated.
+ */
+static void arith_assign(arithc_t *c)
+{
+	long name = c->num;
+	char *s = c->s;
+	size_t used = c->used;
+	int op, j;
+
+	if (c->tok == A_VAR)
+	{
+		arith_next(c);
+		op = c->tok & ~A_ASSIGN;
+		if (c->tok & A_ASSIGN)
+		{
+			if (op)
+				arith_emit(c, A_VAR, name);
+			arith_next(c);
+			arith_assign(c);
+			if (op)
+				arith_emit(c, op, 0);
+			arith_emit(c, A_SET, name);
+			return;
+		}
+		c->s = s;
+		c->used = used;
+		c->tok = A_VAR;
+		c->num = name;
+	}
+	arith_binary(c, 1);
+	if (c->tok != A_QUEST)
+		return;
+	j = arith_emit(c, A_JZ, 0);
+	arith_next(c);
+	arith_expr(c);
+	if (c->tok != A_COLON && !c->err)
+		c->err = "expecting :";
+	op = arith_emit(c, A_JMP, 0);
+	c->ops[j].val = c->nops;
+	arith_next(c);
+	arith_assign(c);
+	c->ops[op].val = c->nops;
+}
+
+/**
+ * arith_expr - compiles an expression, commas included
+ * @c: the compiler state, at the expression's first token
+ *
+ * Each expression of a comma list is evaluated and dropped but the
+ * last one, which is the value of the list. What is wrong with the
+ * text is left in c->err, and compiling stops there.
+ */
+void arith_expr(arithc_t *c)
+{
+	arith_assign(c);
+	while (c->tok == A_COMMA)
+	{
+		arith_emit(c, A_POP, 0);
+		arith_next(c);
+		arith_assign(c);
+	}
+}
@@ -0,0 +1,218 @@
+#include "shell.h"
+
+/*
+ * What each comparison from A_LT to A_NE holds for: bit 0 when the left
+ * side is less, bit 1 when both are equal, bit 2 when it is greater.
+ */
+static const unsigned char arith_cmp[] = {1, 3, 4, 6, 2, 5};
+
+/**
+ * arith_var - gives the value of a variable in an arithmetic expression
+ * @info: the shell state structure
+ * @name: the variable's name
+ * @v: set to the value
+ *
+ * An unset or empty variable is 0; anything else must hold a number,
+ * written the way a number is written in an expression.
+ * Return: 0 on success, -1 if the value is no number, after saying so
+ */
+static int arith_var(info_t *info, char *name, long *v)
+{
+	char *s = param_value(info, name, _strlen(name)), *e;
+
+	*v = 0;
+	while (s && (*s == ' ' || *s == '\t' || *s == '\n'))
+		s++;
+	if (!s || !*s)
+		return (0);
+	errno = 0;
+	*v = strtol(s, &e, 0);
+	while (*e == ' ' || *e == '\t' || *e == '\n')
+		e++;
+	if (!*e && e != s && errno != ERANGE)
+		return (0);
+	arith_error(info, "bad number", s, _strlen(s));
+	return (-1);
+}
+
+/**
+ * arith_apply - applies a unary or binary op to the top of the stack
+ * @op: the op
+ * @st: the stack
+ * @sp: the number of values on it, less one after a binary op
+ *
+ * Sums, differences and products wrap around instead of overflowing,
+ * and shift counts are taken modulo the width of a long.
+ * Return: 0 on success, -1 on a division by zero
+ */
+static int arith_apply(int op, long *st, int *sp)
+{
+	long *a = st + *sp - 1 - IS_ABINARY(op), b = st[*sp - 1];
+	unsigned long ua = *a, ub = b, k = sizeof(long) * 8 - 1;
+
+	*sp -= IS_ABINARY(op);
+	if ((op == A_DIV || op == A_MOD) && !b)
+		return (-1);
+	if (op >= A_LT && op <= A_NE)
+		*a = arith_cmp[op - A_LT] >> ((*a > b) - (*a < b) + 1) & 1;
+	else if (op == A_BOOL || op == A_NOT)
+		*a = op == A_BOOL ? !!b : !b;
+	else if (op == A_NEG || op == A_INV)
+		*a = op == A_NEG ? -ub : ~ub;
+	else if (op == A_MUL || op == A_ADD || op == A_SUB)
+		*a = op == A_MUL ? ua * ub : op == A_ADD ? ua + ub : ua - ub;
+	else if (op == A_DIV || op == A_MOD)
+		*a = b == -1 ? (op == A_DIV ? (long)-ua : 0)
+			: op == A_DIV ? *a / b : *a % b;
+	else if (op == A_SHL || op == A_SHR)
+		*a = op == A_SHL ? (long)(ua << (ub & k)) : *a >> (ub & k);
+	else
+		*a = op == A_AND ? *a & b : op == A_XOR ? *a ^ b : *a | b;
+	return (0);
+}
+
+/**
+ * arith_run - runs the ops of a compiled expression
+ * @info: the shell state structure
+ * @p: the expression
+ * @res: set to its value
+ *
+ * The stack never holds more values than there are ops, so it is
+ * sized once from the arena. Assignments go through var_set(), so a
+ * variable they create is not exported.
+ * Return: 0 on success, -1 on an error, after saying what it was
+ */
+static int arith_run(info_t *info, arith_t *p, long *res)
+{
+	long *st = arena_alloc(info, sizeof(long) * p->nops);
+	arithop_t *o;
+	int pc, sp = 0;
+
+	if (!st)
+		return (_eputs("hsh: out of memory\n"), -1);
+	for (pc = 0; pc < p->nops; pc++)
+	{
+		o = p->ops + pc;
+		if (o->op == A_NUM)
+			st[sp++] = o->val;
+		else if (o->op == A_VAR && arith_var(info, p->names + o->val,
+			st + sp++))
+			return (-1);
+		else if (o->op == A_SET && var_set(info, p->names + o->val,
+			convert_number(st[sp - 1], 10, 0), 0))
+			return (-1);
+		else if (o->op == A_JZ && !st[--sp])
+			pc = o->val - 1;
+		else if (o->op == A_JMP || ((o->op == A_ANDJ || o->op == A_ORJ)
+			&& !st[sp - 1] == (o->op == A_ANDJ)))
+			pc = o->val - 1;
+		else if (o->op == A_ANDJ || o->op == A_ORJ || o->op == A_POP)
+			sp--;
+		else if (o->op >= A_BOOL && arith_apply(o->op, st, &sp))
+			return (arith_error(info, "division by zero", p->text,
+				p->len), -1);
+	}
+	*res = st[sp - 1];
+	return (0);
+}
+
+/**
+ * arith_compile - compiles an arithmetic expression
+ * @info: the shell state structure
+ * @text: the expression
+ * @len: its length
+ * @cache: on to compile into memory of its own, to be cached, off to
+ * compile into the arena
+ *
+ * Return: the compiled expression, NULL on an error, after saying what
+ * it was
+ */
+static arith_t *arith_compile(info_t *info, char *text, size_t len,
+	int cache)
+{
+	arithc_t c;
+	arith_t *p = arena_alloc(info, sizeof(arith_t));
+
+	_memset((void *)&c, 0, sizeof(c));
+	c.s = text;
+	c.end = text + len;
+	c.ops = arena_alloc(info, sizeof(arithop_t) * (2 * len + 2));
+	c.names = arena_alloc(info, 2 * len + 1);
+	if (!p || !c.ops || !c.names)
+		return (_eputs("hsh: out of memory\n"), NULL);
+	arith_next(&c);
+	c.ops->op = A_NUM;
+	c.ops->val = 0;
+	c.nops = c.tok == A_END && !c.err;
+	if (!c.nops)
+		arith_expr(&c);
+	if (c.tok != A_END && !c.err)
+		c.err = "syntax error";
+	if (c.err)
+		return (arith_error(info, c.err, text, len), NULL);
+	if (cache)
+		p = malloc(sizeof(arith_t) + sizeof(arithop_t) * c.nops +
+			c.used + len);
+	if (!p)
+		return (_eputs("hsh: out of memory\n"), NULL);
+	p->ops = cache ? memcpy(p + 1, c.ops, sizeof(arithop_t) * c.nops)
+		: c.ops;
+	p->names = cache ? memcpy(p->ops + c.nops, c.names, c.used)
+		: c.names;
+	p->text = cache ? memcpy(p->names + c.used, text, len) : text;
+	p->len = len;
+	p->nops = c.nops;
+	p->next = NULL;
+	return (p);
+}
+
+/**
+ * arith_eval - evaluates an arithmetic expression
+ * @info: the shell state structure
+ * @text: the expression
+ * @len: its length
+ * @cache: on to look the expression up in, and add it to, the cache of
+ * compiled expressions; off for text that came out of an expansion
+ * @res: set to the value
+ *
+ * An expression is compiled the first time its text is seen, so one
+ * that runs again and again is never parsed again. Once the cache holds
+ * ARITH_CACHE_MAX expressions it is emptied and starts over.
+ * Return: 0 on success, -1 on an error, after saying what it was
+ */
+int arith_eval(info_t *info, char *text, size_t len, int cache, long *res)
+{
+	unsigned int h = 2166136261u;
+	arith_t *p = NULL, **b;
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		h = (h ^ (unsigned char)text[i]) * 16777619u;
+	b = info->arith_hash ? &info->arith_hash[h % ARITH_HASH_SIZE] : NULL;
+	for (p = cache && b ? *b : NULL; p; p = p->next)
+		if (p->hash == h && p->len == len &&
+			!memcmp(p->text, text, len))
+			return (arith_run(info, p, res));
+	if (cache && info->arith_count >= ARITH_CACHE_MAX)
+		arith_clear(info);
+	if (cache && !info->arith_hash)
+	{
+		info->arith_hash = malloc(sizeof(arith_t *) * ARITH_HASH_SIZE);
+		if (info->arith_hash)
+			_memset((void *)info->arith_hash, 0,
+				sizeof(arith_t *) * ARITH_HASH_SIZE);
+	}
+	cache = cache && info->arith_hash;
+	p = arith_compile(info, text, len, cache);
+	if (!p)
+		return (-1);
+	p->hash = h;
+	if (cache)
+	{
+		b = &info->arith_hash[h % ARITH_HASH_SIZE];
+		p->next = *b;
+		*b = p;
+		info->arith_count++;
+	}
+	return (arith_run(info, p, res));
+}
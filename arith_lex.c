@@ -0,0 +1,103 @@
+#include "shell.h"
+
+/*
+ * The operators of arithmetic expressions and their tokens, each one
+ * before any operator it starts with so the longest always matches.
+ */
+static char *const arith_spell[] = {
+	"<<=", ">>=", "<<", ">>", "<=", ">=", "==", "!=", "&&", "||",
+	"*=", "/=", "%=", "+=", "-=", "&=", "^=", "|=",
+	"*", "/", "%", "+", "-", "<", ">", "&", "^", "|", "!", "~",
+	"?", ":", "=", "(", ")", ",", NULL
+};
+static const int arith_tok[] = {
+	A_ASSIGN | A_SHL, A_ASSIGN | A_SHR, A_SHL, A_SHR, A_LE, A_GE, A_EQ,
+	A_NE, A_LAND, A_LOR, A_ASSIGN | A_MUL, A_ASSIGN | A_DIV,
+	A_ASSIGN | A_MOD, A_ASSIGN | A_ADD, A_ASSIGN | A_SUB,
+	A_ASSIGN | A_AND, A_ASSIGN | A_XOR, A_ASSIGN | A_OR,
+	A_MUL, A_DIV, A_MOD, A_ADD, A_SUB, A_LT, A_GT, A_AND, A_XOR, A_OR,
+	A_NOT, A_INV, A_QUEST, A_COLON, A_ASSIGN, A_LPAREN, A_RPAREN, A_COMMA
+};
+
+/**
+ * arith_number - reads a number token
+ * @c: the compiler state, c->s at the first digit
+ *
+ * Numbers are decimal, octal with a leading 0 or hexadecimal with a
+ * leading 0x, as in C; a number running into letters or digits it
+ * cannot have is an error.
+ */
+static void arith_number(arithc_t *c)
+{
+	char *e;
+
+	errno = 0;
+	c->num = strtol(c->s, &e, 0);
+	c->tok = A_NUM;
+	c->s = e;
+	if (errno == ERANGE || (e < c->end && (_isalpha(*e) || *e == '_' ||
+		(*e >= '0' && *e <= '9'))))
+	{
+		c->err = "bad number";
+		c->tok = A_END;
+	}
+}
+
+/**
+ * arith_name - reads a variable name token
+ * @c: the compiler state, c->s at the first letter
+ *
+ * The name is copied to the names of the expression right away, ended
+ * by a null byte, and its offset there is the token's value.
+ */
+static void arith_name(arithc_t *c)
+{
+	char *p = c->s;
+
+	while (p < c->end && (_isalpha(*p) || *p == '_' ||
+		(*p >= '0' && *p <= '9')))
+		p++;
+	memcpy(c->names + c->used, c->s, p - c->s);
+	c->num = c->used;
+	c->used += p - c->s;
+	c->names[c->used++] = 0;
+	c->s = p;
+	c->tok = A_VAR;
+}
+
+/**
+ * arith_next - reads the next token of an arithmetic expression
+ * @c: the compiler state, whose tok is set to the token
+ *
+ * Blanks and newlines between tokens are skipped. Once the text is
+ * used up, or something is wrong with it, every token is A_END.
+ */
+void arith_next(arithc_t *c)
+{
+	size_t k;
+	int i;
+
+	while (c->s < c->end && (*c->s == ' ' || *c->s == '\t' ||
+		*c->s == '\n'))
+		c->s++;
+	c->tok = A_END;
+	if (c->err || c->s >= c->end)
+		return;
+	if (*c->s >= '0' && *c->s <= '9')
+		arith_number(c);
+	else if (_isalpha(*c->s) || *c->s == '_')
+		arith_name(c);
+	if (c->tok != A_END || c->err)
+		return;
+	for (i = 0; arith_spell[i]; i++)
+	{
+		k = _strlen(arith_spell[i]);
+		if (c->s + k <= c->end && !strncmp(c->s, arith_spell[i], k))
+		{
+			c->s += k;
+			c->tok = arith_tok[i];
+			return;
+		}
+	}
+	c->err = "syntax error";
+}
@@ -0,0 +1,134 @@
+#include "shell.h"
+
+/*
+ * Builtins are found through a perfect hash the way gperf builds one:
+ * BUILTIN_SEED is a seed with which builtin_hash() sends every name in
+ * builtintbl to a distinct slot, found offline, and builtin_slots holds
+ * the index + 1 of the entry in each slot (0 for an empty slot). A
+ * builtin is added by appending it to builtintbl; if the seed no longer
+ * works, builtin_init() fails at startup and names one that does, to
+ * put in BUILTIN_SEED. BUILTIN_SLOTS must stay a power of two, and well
+ * above the number of builtins so a seed is found in a few dozen tries.
+ */
+#define BUILTIN_SLOTS	64
+#define BUILTIN_SEED	327u
+#define BUILTIN_SEED_MAX	65536u
+
+static builtin_table builtintbl[] = {
+	{"exit", _myexit, 0},
+	{"env", _myenv, 1},
+	{"help", _myhelp, 1},
+	{"history", _myhistory, 1},
+	{"setenv", _mysetenv, 0},
+	{"unsetenv", _myunsetenv, 0},
+	{"cd", _mycd, 0},
+	{"alias", _myalias, 0},
+	{"launch", _mylaunch, 0},
+	{"hash", _myhash, 0},
+	{"set", _myset, 0},
+	{"jobs", _myjobs, 0},
+	{"wait", _mywait, 0},
+	{"fg", _myfg, 0},
+	{"bg", _mybg, 0},
+	{"kill", _mykill, 0},
+	{"times", _mytimes, 1},
+	{"let", _mylet, 0},
+	{"arith", _mylet, 0},
+	{"export", _myexport, 0},
+	{"readonly", _myreadonly, 0},
+	{"local", _mylocal, 0},
+	{"unset", _myunset, 0},
+	{NULL, NULL, 0}
+};
+
+static unsigned char builtin_slots[BUILTIN_SLOTS];
+
+/**
+ * builtin_hash - FNV-1a hash of a name, folded to a builtin slot
+ * @name: the command name
+ * @seed: the seed to start the hash from
+ *
+ * Return: the slot index, below BUILTIN_SLOTS
+ */
+static unsigned int builtin_hash(const char *name, unsigned int seed)
+{
+	unsigned int h = seed;
+
+	while (*name)
+		h = (h ^ (unsigned char)*name++) * 16777619u;
+	h ^= h >> 15;
+	return (h & (BUILTIN_SLOTS - 1));
+}
+
+/**
+ * get_builtin - looks up a built-in command by name
+ * @name: the command name
+ *
+ * One hash and at most one string compare, however many builtins
+ * there are, so external commands pay almost nothing for the miss.
+ * Return: the table entry for the builtin, or NULL if it is not one
+ */
+builtin_table *get_builtin(char *name)
+{
+	int i = builtin_slots[builtin_hash(name, BUILTIN_SEED)];
+
+	if (!i || _strcmp(name, builtintbl[i - 1].type))
+		return (NULL);
+	return (&builtintbl[i - 1]);
+}
+
+/**
+ * builtin_fill - fills builtin_slots for a seed
+ * @seed: the seed to hash the names with
+ *
+ * Return: the index in builtintbl of the first name whose slot is
+ * taken, -1 if every name has a slot of its own
+ */
+static int builtin_fill(unsigned int seed)
+{
+	unsigned int h;
+	int i;
+
+	_memset((char *)builtin_slots, 0, BUILTIN_SLOTS);
+	for (i = 0; builtintbl[i].type; i++)
+	{
+		h = builtin_hash(builtintbl[i].type, seed);
+		if (builtin_slots[h])
+			return (i);
+		builtin_slots[h] = i + 1;
+	}
+	return (-1);
+}
+
+/**
+ * builtin_init - builds the perfect hash of the builtins
+ *
+ * If BUILTIN_SEED sends two names to the same slot, the builtins added
+ * since it was found need a new one: the first seed that works is
+ * searched for and named, and the shell does not start.
+ * Return: 0 on success, -1 if BUILTIN_SEED does not work, after saying so
+ */
+int builtin_init(void)
+{
+	unsigned int seed;
+	int i = builtin_fill(BUILTIN_SEED);
+
+	if (i == -1)
+		return (0);
+	_eputs("hsh: BUILTIN_SEED sends ");
+	_eputs(builtintbl[i].type);
+	_eputs(" to a slot already taken; ");
+	for (seed = 1; seed < BUILTIN_SEED_MAX && builtin_fill(seed) != -1;
+		seed++)
+		;
+	if (seed < BUILTIN_SEED_MAX)
+	{
+		_eputs("set it to ");
+		_eputs(convert_number(seed, 10, 0));
+	}
+	else
+		_eputs("no seed works, so raise BUILTIN_SLOTS");
+	_eputchar('\n');
+	_eputchar(BUF_FLUSH);
+	return (-1);
+}
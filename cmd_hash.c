@@ -0,0 +1,130 @@
+#include "shell.h"
+
+/**
+ * cmd_hash_key - hashes a command name into a bucket index
+ * @name: the command name
+ *
+ * Return: the bucket index, below CMD_HASH_SIZE
+ */
+static unsigned int cmd_hash_key(char *name)
+{
+	unsigned int h = 5381;
+
+	while (*name)
+		h = h * 33 + (unsigned char)*name++;
+	return (h % CMD_HASH_SIZE);
+}
+
+/**
+ * cmd_hash_entry - looks up a command in the location cache
+ * @info: the info struct holding shell context
+ * @name: the command name
+ *
+ * Return: the cache entry, or NULL if the name was never looked up
+ */
+cmdhash_t *cmd_hash_entry(info_t *info, char *name)
+{
+	cmdhash_t *entry;
+
+	if (!info->cmd_hash)
+		return (NULL);
+	for (entry = info->cmd_hash[cmd_hash_key(name)]; entry;
+		entry = entry->next)
+		if (!_strcmp(entry->name, name))
+			return (entry);
+	return (NULL);
+}
+
+/**
+ * cmd_hash_store - records the resolved location of a command
+ * @info: the info struct holding shell context
+ * @name: the command name
+ * @path: its full path, or NULL to remember that it was not found
+ *
+ * Return: the cache entry, or NULL on allocation failure
+ */
+cmdhash_t *cmd_hash_store(info_t *info, char *name, char *path)
+{
+	cmdhash_t *entry = cmd_hash_entry(info, name);
+	unsigned int k;
+
+	if (!info->cmd_hash)
+	{
+		info->cmd_hash = malloc(sizeof(cmdhash_t *) * CMD_HASH_SIZE);
+		if (!info->cmd_hash)
+			return (NULL);
+		_memset((void *)info->cmd_hash, 0,
+			sizeof(cmdhash_t *) * CMD_HASH_SIZE);
+	}
+	if (!entry)
+	{
+		entry = malloc(sizeof(cmdhash_t));
+		if (!entry)
+			return (NULL);
+		_memset((void *)entry, 0, sizeof(cmdhash_t));
+		entry->name = _strdup(name);
+		k = cmd_hash_key(name);
+		entry->next = info->cmd_hash[k];
+		info->cmd_hash[k] = entry;
+	}
+	free(entry->path);
+	entry->path = path ? _strdup(path) : NULL;
+	entry->stamp = time(NULL);
+	return (entry);
+}
+
+/**
+ * cmd_hash_find - find_path() with the location cache in front of it
+ * @info: the info struct holding shell context
+ * @pathstr: string containing the PATH environment variable
+ * @cmd: the command to locate
+ *
+ * Names containing a '/' are never cached. A cached hit costs one
+ * stat() to make sure the file is still there; a cached miss is
+ * trusted for CMD_HASH_NEG_TTL seconds before PATH is walked again.
+ * Return: the full path to the command if it exists, or NULL if not found
+ */
+char *cmd_hash_find(info_t *info, char *pathstr, char *cmd)
+{
+	cmdhash_t *entry;
+	char *path;
+
+	if (!pathstr || _strchr(cmd, '/'))
+		return (find_path(info, pathstr, cmd));
+	entry = cmd_hash_entry(info, cmd);
+	if (entry && entry->path && is_cmd(info, entry->path))
+		return (entry->hits++, entry->path);
+	if (entry && !entry->path &&
+		time(NULL) - entry->stamp < CMD_HASH_NEG_TTL)
+		return (NULL);
+	path = find_path(info, pathstr, cmd);
+	entry = cmd_hash_store(info, cmd, path);
+	if (!entry || !path)
+		return (path);
+	entry->hits++;
+	return (entry->path);
+}
+
+/**
+ * cmd_hash_clear - forgets every cached command location
+ * @info: the info struct holding shell context
+ */
+void cmd_hash_clear(info_t *info)
+{
+	cmdhash_t *entry, *next;
+	int i;
+
+	if (!info->cmd_hash)
+		return;
+	for (i = 0; i < CMD_HASH_SIZE; i++)
+	{
+		for (entry = info->cmd_hash[i]; entry; entry = next)
+		{
+			next = entry->next;
+			free(entry->name);
+			free(entry->path);
+			free(entry);
+		}
+		info->cmd_hash[i] = NULL;
+	}
+}
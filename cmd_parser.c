@@ -32,10 +32,10 @@ int is_cmd(info_t *info, char *path)
  */
 char *dup_chars(char *pathstr, int start, int stop)
 {
-	static char buf[1024];
+	static char buf[PATH_MAX];
 	int i = 0, k = 0;
 
-	for (k = 0, i = start; i < stop; i++)
+	for (k = 0, i = start; i < stop && k < PATH_MAX - 1; i++)
 		if (pathstr[i] != ':')
 			buf[k++] = pathstr[i];
 	buf[k] = 0;
@@ -67,14 +67,16 @@ char *find_path(info_t *info, char *pathstr, char *cmd)
 		if (!pathstr[i] || pathstr[i] == ':')
 		{
 			path = dup_chars(pathstr, curr_pos, i);
-			if (!*path)
+			if (_strlen(path) + _strlen(cmd) + 2 > PATH_MAX)
+				path = NULL;
+			else if (!*path)
 				_strcat(path, cmd);
 			else
 			{
 				_strcat(path, "/");
 				_strcat(path, cmd);
 			}
-			if (is_cmd(info, path))
+			if (path && is_cmd(info, path))
 				return (path);
 			if (!pathstr[i])
 				break;
@@ -84,3 +86,24 @@ char *find_path(info_t *info, char *pathstr, char *cmd)
 	}
 	return (NULL);
 }
+
+/**
+ * locate_cmd - resolves info->argv[0] to the file to execute
+ * @info: the info struct holding shell context
+ *
+ * Looks the command up through the location cache first, then accepts
+ * argv[0] itself when it names an existing file.
+ * Return: the path to execute, or NULL if the command was not found
+ */
+char *locate_cmd(info_t *info)
+{
+	char *path, *pathenv = _getenv(info, "PATH=");
+
+	path = cmd_hash_find(info, pathenv, info->argv[0]);
+	if (path)
+		return (path);
+	if ((interactive(info) || pathenv || info->argv[0][0] == '/')
+		&& is_cmd(info, info->argv[0]))
+		return (info->argv[0]);
+	return (NULL);
+}
@@ -0,0 +1,98 @@
+#include "shell.h"
+
+/**
+ * now_us - reads the monotonic clock
+ *
+ * Return: the current monotonic time in microseconds
+ */
+long now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000L + ts.tv_nsec / 1000);
+}
+
+/**
+ * stats_begin - starts measuring a command about to be launched
+ * @info: the shell state structure
+ */
+void stats_begin(info_t *info)
+{
+	_memset((void *)&info->stats, 0, sizeof(cmdstats_t));
+	info->stats.start_us = now_us();
+}
+
+/**
+ * stats_add - adds the usage of one reaped process to the command's
+ * @info: the shell state structure
+ * @ru: the resource usage returned by wait4()
+ */
+void stats_add(info_t *info, struct rusage *ru)
+{
+	info->stats.user_us += ru->ru_utime.tv_sec * 1000000L +
+		ru->ru_utime.tv_usec;
+	info->stats.sys_us += ru->ru_stime.tv_sec * 1000000L +
+		ru->ru_stime.tv_usec;
+	if (ru->ru_maxrss > info->stats.maxrss)
+		info->stats.maxrss = ru->ru_maxrss;
+	info->stats.nvcsw += ru->ru_nvcsw;
+	info->stats.nivcsw += ru->ru_nivcsw;
+}
+
+/**
+ * stats_end - finishes measuring a command once it has been reaped
+ * @info: the shell state structure
+ *
+ * With the cmdstats option on, prints a line like
+ * "hsh: 3: stats: real 0m0.002s user 0m0.001s sys 0m0.000s
+ * maxrss 1920kB csw 2/0" to stderr.
+ */
+void stats_end(info_t *info)
+{
+	info->stats.real_us = now_us() - info->stats.start_us;
+	if (!info->cmdstats)
+		return;
+	_eputs(info->fname);
+	_eputs(": ");
+	print_d(info->line_count, STDERR_FILENO);
+	_eputs(": stats: real ");
+	print_duration(info->stats.real_us, STDERR_FILENO);
+	_eputs(" user ");
+	print_duration(info->stats.user_us, STDERR_FILENO);
+	_eputs(" sys ");
+	print_duration(info->stats.sys_us, STDERR_FILENO);
+	_eputs(" maxrss ");
+	_eputs(convert_number(info->stats.maxrss, 10, 0));
+	_eputs("kB csw ");
+	_eputs(convert_number(info->stats.nvcsw, 10, 0));
+	_eputchar('/');
+	_eputs(convert_number(info->stats.nivcsw, 10, 0));
+	_eputchar('\n');
+}
+
+/**
+ * print_duration - prints a time span the way bash's time does
+ * @us: the span in microseconds
+ * @fd: the file descriptor to print to
+ *
+ * The format is minutes, then seconds with three decimals: 0m0.004s
+ */
+void print_duration(long us, int fd)
+{
+	void (*put)(char *) = _puts;
+	char *ms;
+	int i;
+
+	if (fd == STDERR_FILENO)
+		put = _eputs;
+	put(convert_number(us / 60000000L, 10, 0));
+	put("m");
+	put(convert_number(us % 60000000L / 1000000L, 10, 0));
+	put(".");
+	ms = convert_number(us % 1000000L / 1000L, 10, 0);
+	for (i = _strlen(ms); i < 3; i++)
+		put("0");
+	put(ms);
+	put("s");
+}
@@ -0,0 +1,204 @@
+#include "shell.h"
+
+/**
+ * subst_text - copies out the command of a substitution
+ * @s: the ( or opening backquote
+ * @end: the closing ) or backquote
+ *
+ * Within backquotes a backslash only quotes \, ` and $, and is taken
+ * away in front of them, so the command reads as it would in $(...).
+ * Return: the command in memory of its own, NULL if memory ran out
+ */
+static char *subst_text(char *s, char *end)
+{
+	char *text = malloc(end - s), *w = text;
+
+	if (!text)
+		return (NULL);
+	for (s++; s < end; s++)
+	{
+		if (*end == '`' && *s == '\\' && _strchr("\\`$", s[1]))
+			s++;
+		*w++ = *s;
+	}
+	*w = 0;
+	return (text);
+}
+
+/**
+ * subst_builtin - runs a pure builtin of a substitution in the shell
+ * @info: the shell state, info->nodes holding the command's tree
+ * @root: the root node
+ *
+ * A lone command whose plain, unaliased name is a builtin that only
+ * prints saves the fork: its output goes to a memory file, which is
+ * read back once the builtin is done, so output of any size is safe.
+ * The words are expanded into the arena of the outer command, which
+ * frees them along with its own.
+ * Return: a fd open on the output, -1 if the command is not such a
+ * builtin or the memory file could not be made
+ */
+static int subst_builtin(info_t *info, int root)
+{
+	node_t *nd = info->nodes + root;
+	token_t *t = info->toks + nd->tok;
+	builtin_table *b = NULL;
+	char name[16];
+	int fd, saved, *redir;
+
+	if (nd->type == N_CMD && nd->ntok && !nd->flags && !t->flags &&
+		t->len < sizeof(name) &&
+		!alias_find(info, info->line + t->start, t->len))
+	{
+		memcpy(name, info->line + t->start, t->len);
+		name[t->len] = 0;
+		b = get_builtin(name);
+	}
+	if (!b || !b->pure)
+		return (-1);
+	fd = memfd_create("hsh-subst", MFD_CLOEXEC);
+	if (fd == -1)
+		return (-1);
+	saved = fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, 3);
+	if (saved == -1)
+		return (close(fd), -1);
+	dup2(fd, STDOUT_FILENO);
+	info->cmd_toks = t;
+	info->cmd_ntok = nd->ntok;
+	info->arg = node_text(info, nd);
+	info->status = 2;
+	redir = NULL;
+	if (!set_info(info, &info->fname))
+		info->status = redirect(info, t, nd->ntok, &redir) ? 1
+			: b->func(info);
+	_putchar(BUF_FLUSH);
+	undo_redirect(info, redir);
+	dup2(saved, STDOUT_FILENO);
+	close(saved);
+	lseek(fd, 0, SEEK_SET);
+	return (fd);
+}
+
+/**
+ * subst_fork - runs the command of a substitution in a child
+ * @info: the shell state, info->nodes holding the command's tree
+ * @root: the root node
+ * @pid: set to the child's pid
+ *
+ * The child runs the tree like a subshell would, with its output going
+ * to a pipe, and exits with the status of the command.
+ * Return: the read end of the pipe, -1 if it could not be made
+ */
+static int subst_fork(info_t *info, int root, pid_t *pid)
+{
+	int fds[2], ret;
+
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (-1);
+	_eputchar(BUF_FLUSH);
+	*pid = fork();
+	if (*pid == 0)
+	{
+		dup2(fds[1], STDOUT_FILENO);
+		ret = run_node(info, &info->fname, root, 0);
+		if (ret == -2 && info->err_num != -1)
+			info->status = info->err_num;
+		_putchar(BUF_FLUSH);
+		_eputchar(BUF_FLUSH);
+		_exit(info->status);
+	}
+	close(fds[1]);
+	if (*pid == -1)
+		return (close(fds[0]), -1);
+	return (fds[0]);
+}
+
+/**
+ * subst_run - starts the command of a substitution
+ * @info: the shell state structure
+ * @s: the ( of a $(...), or the opening backquote
+ * @end: the closing ) or backquote
+ * @pid: set to the pid of the child running it, 0 if none does
+ *
+ * The command is parsed with token, node and expansion buffers of its
+ * own, since the outer line is still being run. The outer state is
+ * put back whole afterwards, keeping only the arena, the status, the
+ * environment, the alias generation, the directory listings and the
+ * compiled arithmetic expressions the command moved on.
+ * Return: a fd to read the output from, -1 if there is none
+ */
+static int subst_run(info_t *info, char *s, char *end, pid_t *pid)
+{
+	info_t outer = *info;
+	int r, fd = -1;
+
+	*pid = 0;
+	info->line = subst_text(s, end);
+	if (!info->line)
+		return (-1);
+	info->tok_buf = NULL;
+	info->tok_cap = 0;
+	info->node_buf = NULL;
+	info->node_cap = 0;
+	info->xbuf = NULL;
+	info->xlen = info->xcap = 0;
+	_putchar(BUF_FLUSH);
+	r = parse_line(info);
+	if (r >= 0 && (fd = subst_builtin(info, r)) == -1)
+		fd = subst_fork(info, r, pid);
+	else if (r < 0 && r != PARSE_NONE)
+		parse_error(info, r);
+	free(info->tok_buf);
+	free(info->node_buf);
+	free(info->xbuf);
+	free(info->line);
+	outer.arena = info->arena;
+	outer.status = info->status;
+	outer.alias_gen = info->alias_gen;
+	outer.glob_cache = info->glob_cache;
+	outer.env = info->env;
+	outer.locals = info->locals;
+	outer.arith_hash = info->arith_hash;
+	outer.arith_count = info->arith_count;
+	*info = outer;
+	return (fd);
+}
+
+/**
+ * cmd_subst - expands a command substitution into xbuf
+ * @info: the shell state structure
+ * @s: the ( of a $(...), or the opening backquote
+ * @dq: on if the substitution is inside double quotes; if not, the
+ * output is split into fields
+ *
+ * The output is read straight into xbuf and its trailing newlines are
+ * dropped there; the status is that of the command.
+ * Return: the text after the substitution, NULL if memory ran out
+ */
+char *cmd_subst(info_t *info, char *s, int dq)
+{
+	char *end = subst_end(s);
+	size_t mark = info->xlen;
+	pid_t pid;
+	int fd, r = 0, st;
+
+	if (!end)
+		return (xbuf_put(info, *s == '(' ? "$(" : s, 1 + (*s == '(')) ?
+			NULL : s + 1);
+	fd = subst_run(info, s, end, &pid);
+	if (fd != -1)
+	{
+		r = xbuf_read(info, fd);
+		close(fd);
+	}
+	while (pid > 0 && waitpid(pid, &st, 0) == -1 && errno == EINTR)
+		;
+	if (pid > 0)
+		info->status = WIFEXITED(st) ? WEXITSTATUS(st)
+			: 128 + WTERMSIG(st);
+	while (info->xlen > mark && info->xbuf[info->xlen - 1] == '\n')
+		info->xlen--;
+	if (!dq)
+		xbuf_split(info, mark);
+	return (r ? NULL : end + 1);
+}
@@ -0,0 +1,132 @@
+#include "shell.h"
+
+/**
+ * new_node - adds a node to the tree being parsed
+ * @info: the parser state, whose node_buf receives the node
+ * @type: the N_ type of the node
+ * @tok: the index of the node's first token; it spans every token up
+ * to the one the parser is at
+ * @a: the left or only operand
+ * @b: the right operand
+ *
+ * Return: the index of the node, -1 if memory ran out
+ */
+int new_node(info_t *info, int type, int tok, int a, int b)
+{
+	size_t cap = info->node_cap ? info->node_cap * 2 : 64;
+	node_t *nd;
+
+	if ((size_t)info->nnode == info->node_cap)
+	{
+		nd = realloc(info->node_buf, sizeof(*nd) * cap);
+		if (!nd)
+			return (-1);
+		info->node_buf = nd;
+		info->node_cap = cap;
+	}
+	nd = info->node_buf + info->nnode;
+	nd->type = type;
+	nd->flags = 0;
+	nd->tok = tok;
+	nd->ntok = info->tok_pos - tok;
+	nd->a = a;
+	nd->b = b;
+	return (info->nnode++);
+}
+
+/**
+ * parse_line - lexes and parses the text in info->line
+ * @info: the shell state structure
+ *
+ * On success info->toks and info->nodes hold the line's tokens and
+ * tree; on a syntax error info->tok_pos is left at the offending
+ * token. Nothing is reported here, see parse_error().
+ * Return: the index of the root node, PARSE_NONE if the line holds no
+ * command, PARSE_MORE or LEX_OPEN if it needs the next line to be
+ * complete, PARSE_ERR on a syntax error, -1 if memory ran out
+ */
+int parse_line(info_t *info)
+{
+	int n = lex_line(info, info->line);
+
+	info->toks = info->tok_buf;
+	info->ntok = n < 0 ? 0 : n;
+	info->tok_pos = 0;
+	info->nnode = 0;
+	n = n < 0 ? n : parse_list(info, 0);
+	info->nodes = info->node_buf;
+	return (n);
+}
+
+/**
+ * parse_error - reports why parse_line() failed
+ * @info: the shell state structure
+ * @r: what parse_line() returned
+ *
+ * PARSE_MORE and LEX_OPEN are only errors once the input has ended.
+ */
+void parse_error(info_t *info, int r)
+{
+	token_t *t = info->toks + info->tok_pos;
+	char msg[64], *s;
+	int n;
+
+	if (r == -1)
+		_eputs("hsh: out of memory\n");
+	else if (r == LEX_OPEN)
+		syntax_error(info, "Unterminated quoted string");
+	else if (r != PARSE_ERR || TOK_AT(info) == -1)
+		syntax_error(info, "end of file unexpected");
+	else if (t->type == TOK_NEWLINE)
+		syntax_error(info, "newline unexpected");
+	else
+	{
+		s = t->type == TOK_WORD ? info->line + t->start
+			: (char *)tok_text[t->type];
+		n = t->type == TOK_WORD ? (int)t->len : _strlen(s);
+		n = n > 40 ? 40 : n;
+		msg[0] = '"';
+		memcpy(msg + 1, s, n);
+		_strcpy(msg + 1 + n, "\" unexpected");
+		syntax_error(info, msg);
+	}
+}
+
+/**
+ * node_text - gives the text of a node, ended in place
+ * @info: the shell state, info->line holding the text
+ * @nd: the node
+ *
+ * The line is cut right after the node's last token, which only ever
+ * overwrites a blank or the operator that ends the node.
+ * Return: the text, "" for a node without tokens
+ */
+char *node_text(info_t *info, node_t *nd)
+{
+	token_t *t = info->toks + nd->tok;
+
+	if (!nd->ntok)
+		return ("");
+	info->line[t[nd->ntok - 1].start + t[nd->ntok - 1].len] = 0;
+	return (info->line + t->start);
+}
+
+/**
+ * syntax_error - reports a command line that cannot be run
+ * @info: the shell state structure
+ * @msg: what is wrong with it
+ *
+ * Prints the message in the layout sh uses and sets the status to 2.
+ */
+void syntax_error(info_t *info, char *msg)
+{
+	info->line_count += info->linecount_flag == 1;
+	info->linecount_flag = 0;
+	_eputs(info->fname);
+	_eputs(": ");
+	print_d(info->line_count, STDERR_FILENO);
+	_eputs(": Syntax error: ");
+	_eputs(msg);
+	_eputchar('\n');
+	info->status = 2;
+}
@@ -0,0 +1,111 @@
+#include "shell.h"
+
+/**
+ * run_cmd - runs a simple command in the shell
+ * @info: the shell state, info->nodes holding the line's tree
+ * @av: argument vector from main
+ * @nd: the command's node
+ * @tail: on if nothing runs after this command on this line
+ *
+ * A command that is forked and exec'd has its redirections set up in
+ * the child (see fork_cmd()); for anything else, builtins above all,
+ * the shell redirects its own fds and puts them back afterwards. A
+ * command whose words cannot be expanded is not run, and fails with 2.
+ * Return: what the builtin returned, -1 if it was not a builtin
+ */
+static int run_cmd(info_t *info, char **av, node_t *nd, int tail)
+{
+	int ret = -1, *saved = NULL;
+
+	clear_info(info);
+	info->cmd_toks = info->toks + nd->tok;
+	info->cmd_ntok = nd->ntok;
+	info->arg = node_text(info, nd);
+	info->tail_ok = tail && input_at_eof(info);
+	if (set_info(info, av))
+		info->status = 2;
+	else if (!REDIR_IN_CHILD(info) &&
+		redirect(info, info->cmd_toks, info->cmd_ntok, &saved))
+		info->status = 1;
+	else if (!info->argc)
+	{
+		info->line_count += info->linecount_flag == 1;
+		info->linecount_flag = 0;
+		info->status = 0;
+	}
+	else if ((ret = find_builtin(info)) == -1)
+		find_cmd(info);
+	undo_redirect(info, saved);
+	free_info(info, 0);
+	return (ret);
+}
+
+/**
+ * run_list - runs the two sides of a ;, && or || node
+ * @info: the shell state structure
+ * @av: argument vector from main
+ * @nd: the node
+ * @tail: on if nothing runs after the node on this line
+ *
+ * The right side of && only runs if the left side succeeds, that of ||
+ * only if it fails; either way the status is that of the last side
+ * run. Only the right side can be the last command.
+ * Return: -2 if exit was run, else as run_node()
+ */
+static int run_list(info_t *info, char **av, node_t *nd, int tail)
+{
+	int ret = run_node(info, av, nd->a, 0);
+
+	if (ret == -2 || (nd->type == N_AND && info->status) ||
+		(nd->type == N_OR && !info->status))
+		return (ret);
+	return (run_node(info, av, nd->b, tail));
+}
+
+/**
+ * run_node - runs a node of the parsed command line
+ * @info: the shell state, info->nodes holding the line's tree
+ * @av: argument vector from main
+ * @i: the node
+ * @tail: on if nothing runs after the node on this line, so the last
+ * command may be exec'd in place of the shell at the end of the input
+ *
+ * The tree is walked as it stands, so a command that is skipped is
+ * never looked at. Groups run in the shell, with their redirections
+ * undone and their local variables put back afterwards; pipelines,
+ * subshells and background jobs run in children. A pipeline with the
+ * time keyword is timed as a whole.
+ * Return: -2 if exit was run, what the builtin returned for a simple
+ * command, 0 otherwise
+ */
+int run_node(info_t *info, char **av, int i, int tail)
+{
+	node_t *nd = info->nodes + i;
+	cmdstats_t outer = info->timing;
+	int ret = 0, *saved;
+
+	if (nd->flags & NF_TIMED)
+		time_prefix(info);
+	tail = tail && !(nd->flags & NF_TIMED);
+	if (nd->type == N_CMD)
+		ret = run_cmd(info, av, nd, tail);
+	else if (nd->type == N_SEQ || nd->type == N_AND || nd->type == N_OR)
+		ret = run_list(info, av, nd, tail);
+	else if (nd->type == N_GROUP)
+	{
+		info->scope++;
+		if (!redirect(info, info->toks + nd->b,
+			nd->tok + nd->ntok - nd->b, &saved))
+			ret = run_node(info, av, nd->a, tail);
+		else
+			info->status = 1;
+		undo_redirect(info, saved);
+		local_pop(info);
+	}
+	else
+		run_pipeline(info, av, i);
+	if (nd->flags & NF_TIMED)
+		time_report(info);
+	info->timing = outer;
+	return (ret);
+}
@@ -0,0 +1,200 @@
+#include "shell.h"
+
+/*
+ * word_ends - what ends an unquoted word, as a 256-bit table like
+ * word_delims: the null byte, blanks, newline and ; & | < > ( )
+ */
+const unsigned char word_ends[32] = {0x01, 0x06, 0, 0, 0x41, 0x03, 0, 0x58,
+	0, 0, 0, 0, 0, 0, 0, 0x10};
+
+/*
+ * tok_text - the text of each operator, indexed by its TOK_ type
+ */
+const char * const tok_text[TOK_MAX] = {NULL, ";", "\n", "&", "&&", "||",
+	"|", "(", ")", "<", ">", ">>", "<&", ">&", "<>"};
+
+/**
+ * push_tok - makes room for one more token in info->tok_buf
+ * @info: the shell state structure
+ * @n: the number of tokens already in the buffer
+ *
+ * Return: the new token, NULL if memory ran out
+ */
+static token_t *push_tok(info_t *info, int n)
+{
+	size_t cap = info->tok_cap ? info->tok_cap * 2 : 64;
+	token_t *t;
+
+	if ((size_t)n == info->tok_cap)
+	{
+		t = realloc(info->tok_buf, sizeof(*t) * cap);
+		if (!t)
+			return (NULL);
+		info->tok_buf = t;
+		info->tok_cap = cap;
+	}
+	return (info->tok_buf + n);
+}
+
+/**
+ * lex_op - recognises the operator at the start of a string
+ * @s: the string
+ * @n: set to the length of the operator
+ *
+ * The longest operator wins, so && is never read as two &.
+ * Return: the TOK_ type of the operator, TOK_WORD if there is none
+ */
+static int lex_op(char *s, long *n)
+{
+	int type, op = TOK_WORD;
+	long k;
+
+	*n = 0;
+	if (!*s || !IN_TABLE(word_ends, *s))
+		return (TOK_WORD);
+	for (type = TOK_SEMI; type < TOK_MAX; type++)
+	{
+		k = _strlen((char *)tok_text[type]);
+		if (k > *n && starts_with(s, tok_text[type]))
+		{
+			op = type;
+			*n = k;
+		}
+	}
+	return (op);
+}
+
+/**
+ * lex_word - finds the end of the word at the start of a string
+ * @s: the word
+ * @flags: set to the TF_ flags of the word
+ *
+ * Quotes and backslashes stay in the word; they only keep what they
+ * quote from ending it. Inside double quotes a backslash is skipped
+ * along with the next character, which is all it can quote there. A
+ * command substitution is taken in whole, blanks and all, and so is a
+ * ${...} expansion that is closed.
+ * Return: the length of the word, LEX_OPEN if a quote or a command
+ * substitution is left open or the word ends with a backslash
+ */
+static long lex_word(char *s, unsigned char *flags)
+{
+	char *p = s, *close = s, *e, q = 0;
+
+	*flags = 0;
+	for (; *p && (q || p < close || !IN_TABLE(word_ends, *p)); p++)
+	{
+		if (q == '\'')
+			q = *p == '\'' ? 0 : q;
+		else if (*p == '\\')
+		{
+			*flags |= TF_QUOTED;
+			if (!*++p)
+				return (LEX_OPEN);
+		}
+		else if (*p == '"' || (*p == '\'' && !q))
+		{
+			*flags |= TF_QUOTED;
+			q = q ? 0 : *p;
+		}
+		else if (*p == '`' || (*p == '$' && p[1] == '('))
+		{
+			*flags |= TF_DOLLAR;
+			p = subst_end(p + (*p == '$'));
+			if (!p)
+				return (LEX_OPEN);
+		}
+		else if (*p == '$')
+		{
+			*flags |= TF_DOLLAR;
+			e = p[1] == '{' ? brace_end(p + 2) : NULL;
+			close = e && e > close ? e : close;
+		}
+		else if (!q && (*p == '*' || *p == '?' || *p == '['))
+			*flags |= TF_GLOB;
+	}
+	return (q ? LEX_OPEN : p - s);
+}
+
+/**
+ * lex_line - breaks a command line into tokens
+ * @info: the shell state, whose tok_buf receives the tokens
+ * @line: the null-terminated line
+ *
+ * Words and operators are told apart in one pass; a # at the start of
+ * a word starts a comment that runs to the next newline, and a
+ * backslash-newline between words is skipped like a blank. A word of
+ * digits right in front of < or > is the descriptor of the
+ * redirection, which takes in the digits. Tokens only record where
+ * they are in the line, which is never changed here.
+ * Return: the number of tokens, LEX_OPEN if a quote is left open, -1
+ * if memory ran out
+ */
+int lex_line(info_t *info, char *line)
+{
+	char *p = line;
+	unsigned char flags;
+	long n, k;
+	int ntok = 0, type;
+	token_t *t;
+
+	for (;; p += n)
+	{
+		while (IN_TABLE(word_delims, *p) ||
+			(*p == '\\' && p[1] == '\n'))
+			p += *p == '\\' ? 2 : 1;
+		if (*p == '#')
+			while (*p && *p != '\n')
+				p++;
+		if (!*p)
+			return (ntok);
+		type = lex_op(p, &n);
+		flags = 0;
+		if (type == TOK_WORD && (n = lex_word(p, &flags)) < 0)
+			return (LEX_OPEN);
+		t = push_tok(info, ntok++);
+		if (!t)
+			return (-1);
+		t->fd = -1;
+		k = 0;
+		while (type == TOK_WORD && k < n && p[k] >= '0' && p[k] <= '9')
+			k++;
+		if (k == n && k <= 4 && (p[n] == '<' || p[n] == '>'))
+		{
+			t->fd = _atoi(p);
+			type = lex_op(p + n, &k);
+			n += k;
+		}
+		t->start = p - line;
+		t->len = n;
+		t->type = type;
+		t->flags = flags;
+	}
+}
+
+/**
+ * lex_copy - breaks a string into tokens kept apart from info->tok_buf
+ * @info: the shell state structure
+ * @s: the null-terminated string
+ * @n: set to the number of tokens, LEX_OPEN if a quote or substitution
+ * is left open, -1 if memory ran out
+ *
+ * For text lexed while a command line is running, whose tokens are
+ * still in use.
+ * Return: the malloc'd tokens, which point into s, NULL on an error
+ */
+token_t *lex_copy(info_t *info, char *s, int *n)
+{
+	token_t *buf = info->tok_buf, *t;
+	size_t cap = info->tok_cap;
+
+	info->tok_buf = NULL;
+	info->tok_cap = 0;
+	*n = lex_line(info, s);
+	t = info->tok_buf;
+	info->tok_buf = buf;
+	info->tok_cap = cap;
+	if (*n < 0)
+		bfree((void **)&t);
+	return (t);
+}
@@ -0,0 +1,157 @@
+#include "shell.h"
+
+/**
+ * at_word - tells whether the parser is at a given reserved word
+ * @info: the parser state, info->tok_pos being the token
+ * @word: the reserved word
+ *
+ * Reserved words are only recognised unquoted, and only where the
+ * callers look for them, that is where a command starts.
+ * Return: 1 if the token is the word, 0 otherwise
+ */
+static int at_word(info_t *info, char *word)
+{
+	token_t *t = info->toks + info->tok_pos;
+
+	return (TOK_AT(info) == TOK_WORD && !t->flags &&
+		(int)t->len == _strlen(word) &&
+		starts_with(info->line + t->start, word) != NULL);
+}
+
+/**
+ * parse_command - parses a simple command, a { list; } or a ( list )
+ * @info: the parser state
+ *
+ * A simple command takes in every word and redirection up to the
+ * next operator, a group or subshell the redirections that follow it;
+ * every redirection needs a word. Where the redirections start is kept
+ * in the node's b.
+ * Return: the command's node, PARSE_MORE if the tokens ran out,
+ * PARSE_ERR at an unexpected token, -1 if memory ran out
+ */
+static int parse_command(info_t *info)
+{
+	int start = info->tok_pos, type = N_CMD, n = 0, redir = start, t;
+
+	if (at_word(info, "{") || TOK_AT(info) == TOK_LPAREN)
+	{
+		type = TOK_AT(info) == TOK_LPAREN ? N_SUBSHELL : N_GROUP;
+		info->tok_pos++;
+		n = parse_list(info, type == N_SUBSHELL ? ')' : '}');
+		if (n < 0)
+			return (n == PARSE_NONE ? PARSE_ERR : n);
+		redir = ++info->tok_pos;
+	}
+	else if (at_word(info, "}"))
+		return (PARSE_ERR);
+	while (((t = TOK_AT(info)) == TOK_WORD && type == N_CMD) ||
+		IS_REDIR(t))
+	{
+		info->tok_pos++;
+		if (IS_REDIR(t) && TOK_AT(info) != TOK_WORD)
+			return (PARSE_ERR);
+		info->tok_pos += IS_REDIR(t);
+	}
+	if (info->tok_pos == start)
+		return (TOK_AT(info) == -1 ? PARSE_MORE : PARSE_ERR);
+	return (new_node(info, type, start, n, redir));
+}
+
+/**
+ * parse_pipeline - parses [time] command [| command]...
+ * @info: the parser state
+ *
+ * The stages nest to the left, so the last stage is the root's right
+ * operand. A newline may follow a |. time on its own times nothing.
+ * Return: the pipeline's node, or as parse_command()
+ */
+static int parse_pipeline(info_t *info)
+{
+	int timed = at_word(info, "time"), start, n, m;
+
+	info->tok_pos += timed;
+	start = info->tok_pos;
+	if (timed && (TOK_AT(info) == -1 || IS_SEP(TOK_AT(info)) ||
+		TOK_AT(info) == TOK_RPAREN))
+		n = new_node(info, N_CMD, start, 0, 0);
+	else
+		n = parse_command(info);
+	while (n >= 0 && TOK_AT(info) == TOK_PIPE)
+	{
+		info->tok_pos++;
+		while (TOK_AT(info) == TOK_NEWLINE)
+			info->tok_pos++;
+		m = parse_command(info);
+		n = m < 0 ? m : new_node(info, N_PIPE, start, n, m);
+	}
+	if (n >= 0 && timed)
+		info->node_buf[n].flags |= NF_TIMED;
+	return (n);
+}
+
+/**
+ * parse_and_or - parses pipeline [&& pipeline | || pipeline]...
+ * @info: the parser state
+ *
+ * && and || have the same precedence and group to the left; a newline
+ * may follow either.
+ * Return: the node, or as parse_command()
+ */
+static int parse_and_or(info_t *info)
+{
+	int start = info->tok_pos, n = parse_pipeline(info), m, type;
+
+	while (n >= 0 && (TOK_AT(info) == TOK_AND || TOK_AT(info) == TOK_OR))
+	{
+		type = TOK_AT(info) == TOK_AND ? N_AND : N_OR;
+		info->tok_pos++;
+		while (TOK_AT(info) == TOK_NEWLINE)
+			info->tok_pos++;
+		m = parse_pipeline(info);
+		n = m < 0 ? m : new_node(info, type, start, n, m);
+	}
+	return (n);
+}
+
+/**
+ * parse_list - parses and-or lists separated by ;, & or newlines
+ * @info: the parser state, info->tok_pos being where the list starts
+ * @close: ')' or '}' for the list inside a group, which ends at the
+ * matching token and leaves it to the caller, 0 for a whole line
+ *
+ * An and-or list followed by & becomes an N_BG node, and lists join
+ * into N_SEQ nodes from the left.
+ * Return: the list's node, PARSE_NONE if the list is empty, or as
+ * parse_command()
+ */
+int parse_list(info_t *info, int close)
+{
+	int first = info->tok_pos, list = PARSE_NONE, start, n, type;
+
+	for (;;)
+	{
+		while (TOK_AT(info) == TOK_NEWLINE)
+			info->tok_pos++;
+		type = TOK_AT(info);
+		if (type == -1)
+			return (close ? PARSE_MORE : list);
+		if ((close == ')' && type == TOK_RPAREN) ||
+			(close == '}' && at_word(info, "}")))
+			return (list);
+		start = info->tok_pos;
+		n = parse_and_or(info);
+		if (n >= 0 && TOK_AT(info) == TOK_AMP)
+			n = new_node(info, N_BG, start, n, 0);
+		if (n >= 0 && list != PARSE_NONE)
+			n = new_node(info, N_SEQ, first, list, n);
+		if (n < 0)
+			return (n);
+		list = n;
+		type = TOK_AT(info);
+		if (type == TOK_SEMI || type == TOK_AMP || type == TOK_NEWLINE)
+			info->tok_pos++;
+		else if (type != -1 && type != TOK_RPAREN &&
+			!at_word(info, "}"))
+			return (PARSE_ERR);
+	}
+}
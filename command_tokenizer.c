@@ -1,101 +1,163 @@
 #include "shell.h"
 
+/*
+ * word_delims - the blanks that separate words, as a 256-bit table:
+ * bit c % 8 of byte c / 8 is set for '\t' and ' '.
+ */
+const unsigned char word_delims[32] = {0, 0x02, 0, 0, 0x01};
+
 /**
- * strtow - breaks up a string into an array of words
- * based on a single character delimiter
- * @str: the string to be tokenized
- * @d: the delimiter character used to tokenize the string
- * Return: a dynamically allocated array of tokenized strings,
- * or NULL if memory allocation fails
+ * unquote - copies a word with its quotes and backslashes removed
+ * @dst: where the copy goes, with room for len bytes
+ * @s: the word as it stands in the line
+ * @len: its length
+ *
+ * Inside double quotes a backslash only quotes \, $, `, " and newline,
+ * and is kept in front of anything else. A quoted newline is removed.
+ * Return: the length of the copy, which is not null-terminated
  */
-char **strtow(char *str, char *d)
+static size_t unquote(char *dst, char *s, size_t len)
 {
-	int i, j, k, m, numwords = 0;
-	char **s;
+	char *end = s + len, *d = dst, q = 0;
 
-	if (str == NULL || str[0] == 0)
-		return (NULL);
-	if (!d)
-		d = " ";
-	for (i = 0; str[i] != '\0'; i++)
-		if (!is_delim(str[i], d) && (is_delim(str[i + 1], d) || !str[i + 1]))
-			numwords++;
+	for (; s < end; s++)
+	{
+		if (q != '\'' && *s == '\\' && s + 1 < end &&
+			(!q || _strchr("\\$`\"\n", s[1])))
+		{
+			if (*++s != '\n')
+				*d++ = *s;
+		}
+		else if ((*s == '"' && q != '\'') || (*s == '\'' && q != '"'))
+			q = q ? 0 : *s;
+		else
+			*d++ = *s;
+	}
+	return (d - dst);
+}
 
-	if (numwords == 0)
-		return (NULL);
-	s = malloc((1 + numwords) * sizeof(char *));
-	if (!s)
+/**
+ * tokenize - builds the argument vector of a command from its tokens
+ * @info: the shell state structure, whose arena holds the result
+ * @t: the command's tokens, which point into info->line
+ * @n: the number of tokens
+ *
+ * Works in a single pass: the words are copied, each followed by a
+ * null byte, into one arena allocation sized for the worst case, and
+ * only words the lexer saw quotes in go through unquote(). Words with
+ * a $ in them keep their quotes for replace_vars(), and redirections
+ * are left out along with their words, which redirect() expands.
+ * Nothing is freed separately; arena_reset() releases it all.
+ * Return: a null-terminated array of words, empty if there are only
+ * redirections, or NULL if there are no tokens or memory ran out
+ */
+char **tokenize(info_t *info, token_t *t, int n)
+{
+	size_t len = 0;
+	char **argv, *w, *s;
+	int i, k;
+
+	for (i = 0; i < n; i++)
+		len += t[i].len + 1;
+	argv = n ? arena_alloc(info, sizeof(char *) * (n + 1) + len) : NULL;
+	if (!argv)
 		return (NULL);
-	for (i = 0, j = 0; j < numwords; j++)
+	w = (char *)(argv + n + 1);
+	for (i = 0, k = 0; k < n; k++, t++)
 	{
-		while (is_delim(str[i], d))
-			i++;
-		k = 0;
-		while (!is_delim(str[i + k], d) && str[i + k])
+		if (IS_REDIR(t->type))
+		{
 			k++;
-		s[j] = malloc((k + 1) * sizeof(char));
-		if (!s[j])
+			t++;
+			continue;
+		}
+		argv[i++] = w;
+		s = info->line + t->start;
+		if ((t->flags & (TF_QUOTED | TF_DOLLAR)) == TF_QUOTED)
+			w += unquote(w, s, t->len);
+		else
+			w = (char *)memcpy(w, s, t->len) + t->len;
+		*w++ = 0;
+	}
+	argv[i] = NULL;
+	return (argv);
+}
+
+/**
+ * subst_end - finds the end of a command substitution
+ * @s: the ( of a $(...), or the opening backquote
+ *
+ * Inside $(...) quotes, nested substitutions and balanced parentheses
+ * are stepped over; a backquoted command ends at the first backquote
+ * that is not escaped.
+ * Return: the closing ) or backquote, NULL if there is none
+ */
+char *subst_end(char *s)
+{
+	int depth = 0, dq = 0;
+	char *p;
+
+	if (*s == '`')
+	{
+		for (p = s + 1; *p && *p != '`'; p++)
+			if (*p == '\\' && p[1])
+				p++;
+		return (*p ? p : NULL);
+	}
+	for (p = s + 1; *p; p++)
+	{
+		if (*p == '\\' && p[1])
+			p++;
+		else if (*p == '"')
+			dq = !dq;
+		else if (*p == '\'' && !dq)
+		{
+			p = _strchr(p + 1, '\'');
+			if (!p)
+				return (NULL);
+		}
+		else if (*p == '`' || (*p == '$' && p[1] == '('))
 		{
-			for (k = 0; k < j; k++)
-				free(s[k]);
-			free(s);
-			return (NULL);
+			p = subst_end(p + (*p == '$'));
+			if (!p)
+				return (NULL);
 		}
-		for (m = 0; m < k; m++)
-			s[j][m] = str[i++];
-		s[j][m] = 0;
+		else if (!dq && *p == '(')
+			depth++;
+		else if (!dq && *p == ')' && !depth--)
+			return (p);
 	}
-	s[j] = NULL;
-	return (s);
+	return (NULL);
 }
 
 /**
- * strtow2 - dissects a string into words based on a set of delimiters
- * @str: the string to be divided
- * @d: the string containing delimiter characters
- * Return: an array of words derived from the string, or
- * NULL if the operation fails
+ * brace_end - finds the } that closes a ${...} expansion
+ * @s: the text right after the ${
  *
- * This function analyzes a string and separates it into an array
- * of words, ignoring
- * consecutive delimiters and only considering non-delimiter
- * sequences as words.
+ * Quoted text and nested ${...} are stepped over, so the default in
+ * ${X:-"}"} or ${X:-${Y}} does not end the expansion early.
+ * Return: the closing }, NULL if there is none
  */
-char **strtow2(char *str, char d)
+char *brace_end(char *s)
 {
-	int i, j, k, m, numwords = 0;
-	char **s;
+	int depth = 0;
+	char q = 0;
 
-	if (str == NULL || str[0] == 0)
-		return (NULL);
-	for (i = 0; str[i] != '\0'; i++)
-		if ((str[i] != d && str[i + 1] == d) ||
-		    (str[i] != d && !str[i + 1]) || str[i + 1] == d)
-			numwords++;
-	if (numwords == 0)
-		return (NULL);
-	s = malloc((1 + numwords) * sizeof(char *));
-	if (!s)
-		return (NULL);
-	for (i = 0, j = 0; j < numwords; j++)
+	for (; *s; s++)
 	{
-		while (str[i] == d && str[i] != d)
-			i++;
-		k = 0;
-		while (str[i + k] != d && str[i + k] && str[i + k] != d)
-			k++;
-		s[j] = malloc((k + 1) * sizeof(char));
-		if (!s[j])
+		if (*s == '\\' && q != '\'' && s[1])
+			s++;
+		else if (q)
+			q = *s == q ? 0 : q;
+		else if (*s == '\'' || *s == '"')
+			q = *s;
+		else if (*s == '$' && s[1] == '{')
 		{
-			for (k = 0; k < j; k++)
-				free(s[k]);
-			free(s);
-			return (NULL);
+			depth++;
+			s++;
 		}
-		for (m = 0; m < k; m++)
-			s[j][m] = str[i++];
-		s[j][m] = 0;
+		else if (*s == '}' && !depth--)
+			return (s);
 	}
-	s[j] = NULL;
-	return (s);
+	return (NULL);
 }
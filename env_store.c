@@ -0,0 +1,180 @@
+#include "shell.h"
+
+/**
+ * env_probe - finds the index slot of a variable
+ * @es: the environment store, which has slots
+ * @name: the name, which need not be null-terminated
+ * @n: the length of the name
+ * @h: set to the hash of the name
+ *
+ * Linear probing from the slot the hash gives; the table is never more
+ * than three quarters full, so an empty slot always ends the search.
+ * Return: the slot holding the variable, or if it is not set, the slot
+ * it would go in: the first tombstone on the way, else the empty slot
+ */
+static int *env_probe(envstore_t *es, char *name, size_t n,
+	unsigned int *h)
+{
+	int *tomb = NULL, k;
+	envvar_t *v;
+	size_t i;
+
+	for (*h = 2166136261u, i = 0; i < n; i++)
+		*h = (*h ^ (unsigned char)name[i]) * 16777619u;
+	for (i = *h & (es->icap - 1);; i = (i + 1) & (es->icap - 1))
+	{
+		k = es->index[i];
+		if (!k)
+			return (tomb ? tomb : es->index + i);
+		if (k == ENV_TOMB)
+		{
+			tomb = tomb ? tomb : es->index + i;
+			continue;
+		}
+		v = es->vars + k - 1;
+		if (v->hash == *h && v->nlen == n && !strncmp(v->str, name, n))
+			return (es->index + i);
+	}
+}
+
+/**
+ * env_rehash - rebuilds the index of the environment store
+ * @es: the environment store
+ * @grow: on to double the room in vars and envp first
+ *
+ * The holes left by unset variables are squeezed out of vars, keeping
+ * the order of the others, and the new table is sized so it is at most
+ * half full, with no tombstones. envp does not move.
+ * Return: 0 on success, -1 if memory ran out, the store left as it was
+ */
+static int env_rehash(envstore_t *es, int grow)
+{
+	size_t icap = ENV_MIN_SLOTS, cap = es->cap ? es->cap * 2 : 16, i, k;
+	int *index = NULL;
+	void *p = NULL;
+
+	while (icap < es->live * 2 + 2)
+		icap *= 2;
+	if (grow && (p = realloc(es->vars, sizeof(envvar_t) * cap)))
+		es->vars = p;
+	if (grow && p && (p = realloc(es->envp, sizeof(char *) * (cap + 1))))
+	{
+		es->envp = p;
+		es->cap = cap;
+	}
+	if (!grow || p)
+		index = malloc(sizeof(int) * icap);
+	if (!index)
+		return (-1);
+	_memset((void *)index, 0, sizeof(int) * icap);
+	for (i = 0, k = 0; i < es->n; i++)
+		if (es->vars[i].str)
+			es->vars[k++] = es->vars[i];
+	for (i = 0; i < k; i++)
+	{
+		for (cap = es->vars[i].hash & (icap - 1); index[cap];)
+			cap = (cap + 1) & (icap - 1);
+		index[cap] = i + 1;
+	}
+	free(es->index);
+	es->index = index;
+	es->icap = icap;
+	es->n = es->used = k;
+	return (0);
+}
+
+/**
+ * env_find - looks up an environment variable
+ * @info: the shell state structure
+ * @name: the name, which need not be null-terminated
+ * @n: the length of the name
+ *
+ * Return: the variable, NULL if it is not set
+ */
+envvar_t *env_find(info_t *info, char *name, size_t n)
+{
+	envstore_t *es = &info->env;
+	unsigned int h;
+	int *slot;
+
+	if (!es->icap)
+		return (NULL);
+	slot = env_probe(es, name, n, &h);
+	return (*slot > 0 ? es->vars + *slot - 1 : NULL);
+}
+
+/**
+ * env_set - sets an environment variable
+ * @info: the shell state structure
+ * @str: the variable as NAME=value, in memory the store takes over
+ * @n: the length of the name
+ *
+ * A variable that is already set keeps its flags, its place in the
+ * order and, if it is exported, its slot in envp, which is patched; one
+ * that is not goes last, with no flags, and stays out of envp until
+ * env_flags() exports it. vars doubles when it is full, unless half of
+ * it is holes, which are squeezed out instead.
+ * Return: the variable, NULL if memory ran out, @str then being the
+ * caller's still
+ */
+envvar_t *env_set(info_t *info, char *str, size_t n)
+{
+	envstore_t *es = &info->env;
+	envvar_t *v;
+	unsigned int h;
+	int *slot;
+
+	if ((es->n == es->cap || (es->used + 1) * 4 > es->icap * 3) &&
+		env_rehash(es, es->n == es->cap && es->live * 2 >= es->n))
+		return (NULL);
+	slot = env_probe(es, str, n, &h);
+	if (*slot > 0)
+	{
+		v = es->vars + *slot - 1;
+		free(v->str);
+		v->str = str;
+		if (v->flags & VAR_EXPORT)
+			es->envp[v->pos] = str;
+		return (v);
+	}
+	es->used += !*slot;
+	v = es->vars + es->n;
+	v->str = str;
+	v->nlen = n;
+	v->hash = h;
+	v->flags = 0;
+	*slot = ++es->n;
+	es->live++;
+	return (v);
+}
+
+/**
+ * env_unset - removes an environment variable
+ * @info: the shell state structure
+ * @name: the name, which need not be null-terminated
+ * @n: the length of the name
+ *
+ * The variable leaves envp, then a hole in vars and a tombstone in the
+ * index; holes at the end of vars are given back right away.
+ * Return: 1 if the variable was set, 0 if not
+ */
+int env_unset(info_t *info, char *name, size_t n)
+{
+	envstore_t *es = &info->env;
+	unsigned int h;
+	int *slot;
+
+	if (!es->icap)
+		return (0);
+	slot = env_probe(es, name, n, &h);
+	if (*slot <= 0)
+		return (0);
+	env_flags(info, es->vars + *slot - 1, 0);
+	free(es->vars[*slot - 1].str);
+	es->vars[*slot - 1].str = NULL;
+	*slot = ENV_TOMB;
+	es->live--;
+	while (es->n && !es->vars[es->n - 1].str)
+		es->n--;
+	return (1);
+}
@@ -5,54 +5,31 @@
  * variable array
  * @info: Structure containing shell state, including environment variables
  *
- * Returns the current environment as a string array. If the
- * environment has changed,
- * the array is updated before being returned. Always
- * Return: 0.
+ * The env store keeps the array up to date as variables are set and
+ * unset, so it is never rebuilt or copied here.
+ * Return: the array, which the next change to the environment alters
  */
 char **get_environ(info_t *info)
 {
-	if (!info->environ || info->env_changed)
-	{
-		info->environ = list_to_strings(info->env);
-		info->env_changed = 0;
-	}
+	static char *none[] = {NULL};
 
-	return (info->environ);
+	return (info->env.envp ? info->env.envp : none);
 }
 
 /**
  * _unsetenv - Deletes an environment variable
- * @info: Structure with shell information and the environment list
+ * @info: Structure with shell information and the environment store
  * @var: Variable name to search for and delete
  *
- * Iterates over the environment list to find and remove
- * the variable 'var'.
+ * The variable is looked up by its hash, so this costs the same however
+ * big the environment is. A read-only variable is not deleted.
  * Return: 1 if the variable was deleted, 0 otherwise.
  */
 int _unsetenv(info_t *info, char *var)
 {
-	list_t *node = info->env;
-	size_t i = 0;
-	char *p;
-
-	if (!node || !var)
+	if (!var)
 		return (0);
-
-	while (node)
-	{
-		p = starts_with(node->str, var);
-		if (p && *p == '=')
-		{
-			info->env_changed = delete_node_at_index(&(info->env), i);
-			i = 0;
-			node = info->env;
-			continue;
-		}
-		node = node->next;
-		i++;
-	}
-	return (info->env_changed);
+	return (var_unset(info, var) == 1);
 }
 
 /**
@@ -61,42 +38,64 @@ int _unsetenv(info_t *info, char *var)
  * @var: The environment variable to set or modify
  * @value: The value to assign to the environment variable
  *
- * Allocates a new buffer and constructs the environment
- * string as 'VAR=VALUE'.
- * If the variable already exists, it updates the value;
- * otherwise, it adds a new variable.
- * Return: 0 on success, 1 on memory allocation failure.
+ * The variable is set as by var_set(), and exported.
+ * Return: 0 on success, 1 if it is read-only or memory ran out.
  */
 int _setenv(info_t *info, char *var, char *value)
 {
-	char *buf = NULL;
-	list_t *node;
-	char *p;
-
 	if (!var || !value)
 		return (0);
+	return (var_set(info, var, value, VAR_EXPORT) ? 1 : 0);
+}
 
-	buf = malloc(_strlen(var) + _strlen(value) + 2);
-	if (!buf)
-		return (1);
-	_strcpy(buf, var);
-	_strcat(buf, "=");
-	_strcat(buf, value);
-	node = info->env;
-	while (node)
+/**
+ * env_free - frees the environment store
+ * @info: Pointer to the main shell info structure
+ */
+void env_free(info_t *info)
+{
+	envstore_t *es = &info->env;
+	size_t i;
+
+	for (i = 0; i < es->n; i++)
+		free(es->vars[i].str);
+	free(es->vars);
+	free(es->index);
+	free(es->envp);
+	_memset((void *)es, 0, sizeof(envstore_t));
+}
+
+/**
+ * env_flags - sets the flags of a variable of the environment store
+ * @info: Pointer to the main shell info structure
+ * @v: the variable
+ * @flags: its new VAR_ flags
+ *
+ * A variable that gets VAR_EXPORT goes last in envp. One that loses it
+ * leaves its slot to the last string in envp, whose variable is told
+ * so; envp thus only ever holds exported variables, with no holes.
+ */
+void env_flags(info_t *info, envvar_t *v, int flags)
+{
+	envstore_t *es = &info->env;
+	int change = (flags ^ v->flags) & VAR_EXPORT;
+	envvar_t *u;
+	char *last;
+
+	if (change && (flags & VAR_EXPORT))
+	{
+		v->pos = es->nexp;
+		es->envp[es->nexp++] = v->str;
+		es->envp[es->nexp] = NULL;
+	}
+	else if (change)
 	{
-		p = starts_with(node->str, var);
-		if (p && *p == '=')
-		{
-			free(node->str);
-			node->str = buf;
-			info->env_changed = 1;
-			return (0);
-		}
-		node = node->next;
+		last = es->envp[--es->nexp];
+		es->envp[v->pos] = last;
+		es->envp[es->nexp] = NULL;
+		u = env_find(info, last, _strchr(last, '=') - last);
+		if (u != v)
+			u->pos = v->pos;
 	}
-	add_node_end(&(info->env), buf, 0);
-	free(buf);
-	info->env_changed = 1;
-	return (0);
+	v->flags = flags;
 }
@@ -2,45 +2,50 @@
 
 /**
  * _getenv - obtains the value of an environment variable
- * @info: shell state information, used for accessing the env list
- * @name: the name of the environment variable to find
+ * @info: shell state information, used for accessing the env store
+ * @name: the name of the environment variable to find, which may end
+ * in an =
  *
- * Traverses the env linked list to find the variable
- * 'name' and returns its value.
- * Return: NULL if the variable is not found.
+ * Looks the variable 'name' up in the hashed env store and returns
+ * its value.
+ * Return: NULL if the variable is not found or is empty.
  */
 char *_getenv(info_t *info, const char *name)
 {
-	list_t *node = info->env;
-	char *p;
+	size_t n = _strlen((char *)name);
+	envvar_t *v;
 
-	while (node)
-	{
-		p = starts_with(node->str, name);
-		if (p && *p)
-			return (p);
-		node = node->next;
-	}
+	n -= n && name[n - 1] == '=';
+	v = env_find(info, (char *)name, n);
+	if (v && v->str[n + 1])
+		return (v->str + n + 1);
 	return (NULL);
 }
 
 /**
- * populate_env_list - creates a linked list from the environment variables
- * @info: shell state information, including the head of the env list
+ * populate_env_list - fills the env store from the environment variables
+ * @info: shell state information, including the env store
  *
  * Loops over the system environment variables
- * and appends each one to a new linked list.
- * The head of the list is stored in the info structure.
+ * and adds a copy of each one to the store, in their order, exported.
  * Return: 0.
  */
 int populate_env_list(info_t *info)
 {
-	list_t *node = NULL;
+	char *s, *eq;
+	envvar_t *v;
 	size_t i;
 
 	for (i = 0; environ[i]; i++)
-		add_node_end(&node, environ[i], 0);
-	info->env = node;
+	{
+		s = _strdup(environ[i]);
+		eq = s ? _strchr(s, '=') : NULL;
+		v = eq ? env_set(info, s, eq - s) : NULL;
+		if (v)
+			env_flags(info, v, VAR_EXPORT);
+		else
+			free(s);
+	}
 	return (0);
 }
 
@@ -69,13 +74,22 @@ int _mysetenv(info_t *info)
  * _myenv - prints the current environment to stdout
  * @info: shell state information including the env list
  *
- * Outputs the entire environment list to stdout, using the
- * print_list_str function.
+ * Outputs the entire environment to stdout, one variable per
+ * line, in the order the variables were set; shell variables that are
+ * not exported are left out.
  * Return: 0 always.
  */
 int _myenv(info_t *info)
 {
-	print_list_str(info->env);
+	envvar_t *v = info->env.vars;
+	size_t i;
+
+	for (i = 0; i < info->env.n; i++)
+		if (v[i].str && (v[i].flags & VAR_EXPORT))
+		{
+			_puts(v[i].str);
+			_putchar('\n');
+		}
 	return (0);
 }
 
@@ -109,7 +109,7 @@ char *convert_number(long int num, int base, int flags)
 
 	if (!(flags & CONVERT_UNSIGNED) && num < 0)
 	{
-		n = -num;
+		n = 0UL - n;
 		sign = '-';
 
 	}
@@ -126,24 +126,3 @@ char *convert_number(long int num, int base, int flags)
 		*--ptr = sign;
 	return (ptr);
 }
-
-/**
- * remove_comments - nullifies comments within a command line
- * @buf: pointer to the command line string
- *
- * Scans the command line for a '#' character that signifies the start of
- * a comment.
- * If found, the function replaces it with a null
- * character to ignore the comment.
- */
-void remove_comments(char *buf)
-{
-	int i;
-
-	for (i = 0; buf[i] != '\0'; i++)
-		if (buf[i] == '#' && (!i || buf[i - 1] == ' '))
-		{
-			buf[i] = '\0';
-			break;
-		}
-}
@@ -5,13 +5,31 @@
  * @info: holds all the shell state and command information
  *
  * This function creates a new process where the command provided in
- * info->path is executed. It waits for the command to finish and
- * captures its exit status.
+ * info->path is executed, using the backend selected by launch_mode.
+ * It waits for the command to finish and captures its exit status.
+ * The plain fork backend sets up the redirections in the child. The
+ * fork-server only gets stdin, stdout and stderr, so while a fd above 2
+ * is redirected, the command is forked here instead. What the shell
+ * has buffered is written first, so it comes out before the command's
+ * output and the child has none to write again.
  */
 void fork_cmd(info_t *info)
 {
 	pid_t child_pid;
 
+	_putchar(BUF_FLUSH);
+	_eputchar(BUF_FLUSH);
+	stats_begin(info);
+	if (info->launch_mode == LAUNCH_SPAWN ||
+		info->launch_mode == LAUNCH_VFORK)
+	{
+		wait_cmd(info, info->launch_mode == LAUNCH_SPAWN ?
+			spawn_cmd(info) : vfork_cmd(info));
+		return;
+	}
+	if (info->launch_mode == LAUNCH_SERVER && !info->redir_high &&
+		!server_cmd(info))
+		return;
 	child_pid = fork();
 	if (child_pid == -1)
 	{
@@ -21,6 +39,9 @@ void fork_cmd(info_t *info)
 	}
 	if (child_pid == 0)
 	{
+		if (REDIR_IN_CHILD(info) &&
+			redirect(info, info->cmd_toks, info->cmd_ntok, NULL))
+			_exit(1);
 		if (execve(info->path, info->argv, get_environ(info)) == -1)
 		{
 			free_info(info, 1);
@@ -31,15 +52,7 @@ void fork_cmd(info_t *info)
 		/* TODO: PUT ERROR FUNCTION */
 	}
 	else
-	{
-		wait(&(info->status));
-		if (WIFEXITED(info->status))
-		{
-			info->status = WEXITSTATUS(info->status);
-			if (info->status == 126)
-				print_error(info, "Permission denied\n");
-		}
-	}
+		wait_cmd(info, child_pid);
 }
 
 /**
@@ -52,28 +65,28 @@ void fork_cmd(info_t *info)
  */
 int hsh(info_t *info, char **av)
 {
-	ssize_t r = 0;
-	int builtin_ret = 0;
+	int r = 0, builtin_ret = 0;
 
+	info->fname = av[0];
 	while (r != -1 && builtin_ret != -2)
 	{
 		clear_info(info);
+		notify_jobs(info);
 		if (interactive(info))
 			_puts("$ ");
 		_eputchar(BUF_FLUSH);
 		r = get_input(info);
-		if (r != -1)
-		{
-			set_info(info, av);
-			builtin_ret = find_builtin(info);
-			if (builtin_ret == -1)
-				find_cmd(info);
-		}
-		else if (interactive(info))
+		if (r >= 0)
+			builtin_ret = run_node(info, av, r, 1);
+		else if (r == PARSE_NONE)
+			info->line_count += info->linecount_flag == 1;
+		else if (r == -1 && interactive(info))
 			_putchar('\n');
+		glob_clear(info);
 		free_info(info, 0);
 	}
-	write_history(info);
+	if (!info->src || info->src_map)
+		write_history(info);
 	free_info(info, 1);
 	if (!interactive(info) && info->status)
 		exit(info->status);
@@ -96,27 +109,12 @@ int hsh(info_t *info, char **av)
  */
 int find_builtin(info_t *info)
 {
-	int i, built_in_ret = -1;
-	builtin_table builtintbl[] = {
-		{"exit", _myexit},
-		{"env", _myenv},
-		{"help", _myhelp},
-		{"history", _myhistory},
-		{"setenv", _mysetenv},
-		{"unsetenv", _myunsetenv},
-		{"cd", _mycd},
-		{"alias", _myalias},
-		{NULL, NULL}
-	};
+	builtin_table *builtin = get_builtin(info->argv[0]);
 
-	for (i = 0; builtintbl[i].type; i++)
-		if (_strcmp(info->argv[0], builtintbl[i].type) == 0)
-		{
-			info->line_count++;
-			built_in_ret = builtintbl[i].func(info);
-			break;
-		}
-	return (built_in_ret);
+	if (!builtin)
+		return (-1);
+	info->line_count++;
+	return (builtin->func(info));
 }
 
 /**
@@ -143,22 +141,18 @@ void find_cmd(info_t *info)
 	if (!k)
 		return;
 
-	path = find_path(info, _getenv(info, "PATH="), info->argv[0]);
+	path = locate_cmd(info);
 	if (path)
 	{
 		info->path = path;
+		if (info->tail_ok)
+			tail_exec(info);
 		fork_cmd(info);
 	}
-	else
+	else if (*(info->arg) != '\n')
 	{
-		if ((interactive(info) || _getenv(info, "PATH=")
-			|| info->argv[0][0] == '/') && is_cmd(info, info->argv[0]))
-			fork_cmd(info);
-		else if (*(info->arg) != '\n')
-		{
-			info->status = 127;
-			print_error(info, "not found\n");
-		}
+		info->status = 127;
+		print_error(info, "not found\n");
 	}
 }
 
@@ -0,0 +1,175 @@
+#include "shell.h"
+
+/**
+ * recv_request - receives one launch request in the fork-server
+ * @sock: the socket connected to the shell
+ * @req: the request header, filled in here
+ * @fds: set to the command's stdin, stdout and stderr
+ *
+ * Return: the malloc'd payload, or NULL once the shell has gone away
+ */
+static char *recv_request(int sock, srvreq_t *req, int *fds)
+{
+	struct msghdr mh;
+	struct iovec iov;
+	struct cmsghdr *cm;
+	char ctl[CMSG_SPACE(sizeof(int) * 3)], *msg;
+	int i;
+
+	_memset((void *)&mh, 0, sizeof(mh));
+	iov.iov_base = req;
+	iov.iov_len = sizeof(*req);
+	mh.msg_iov = &iov;
+	mh.msg_iovlen = 1;
+	mh.msg_control = ctl;
+	mh.msg_controllen = sizeof(ctl);
+	if (recvmsg(sock, &mh, MSG_CMSG_CLOEXEC) != (ssize_t)sizeof(*req))
+		return (NULL);
+	cm = CMSG_FIRSTHDR(&mh);
+	if (!cm || cm->cmsg_type != SCM_RIGHTS)
+		return (NULL);
+	for (i = 0; i < 3; i++)
+		fds[i] = ((int *)CMSG_DATA(cm))[i];
+	msg = malloc(req->len);
+	if (!msg || read_full(sock, msg, req->len))
+	{
+		for (i = 0; i < 3; i++)
+			close(fds[i]);
+		return (free(msg), NULL);
+	}
+	return (msg);
+}
+
+/**
+ * server_child - execs a requested command in a fork-server child
+ * @msg: the request payload
+ * @req: the request header
+ * @fds: the command's stdin, stdout and stderr
+ *
+ * Exits with the same codes fork_cmd()'s child uses. Never returns.
+ */
+static void server_child(char *msg, srvreq_t *req, int *fds)
+{
+	char **argv, *cwd = msg, *path, *p;
+	int i;
+
+	argv = malloc(sizeof(char *) * (req->argc + req->envc + 2));
+	if (!argv)
+		_exit(1);
+	path = cwd + _strlen(cwd) + 1;
+	p = path + _strlen(path) + 1;
+	for (i = 0; i < req->argc + req->envc + 1; i++)
+	{
+		argv[i] = i == req->argc ? NULL : p;
+		if (i != req->argc)
+			p += _strlen(p) + 1;
+	}
+	argv[i] = NULL;
+	for (i = 0; i < 3; i++)
+		dup2(fds[i], i);
+	signal(SIGINT, SIG_DFL);
+	signal(SIGQUIT, SIG_DFL);
+	if (*cwd && chdir(cwd) == -1)
+		_exit(1);
+	execve(path, argv, argv + req->argc + 1);
+	_exit(errno == EACCES ? 126 : 1);
+}
+
+/**
+ * start_fork_server - starts the fork-server helper process
+ * @info: the shell state structure
+ *
+ * The helper is a fork of the shell that only ever receives requests,
+ * forks and execs them, and reports back the wait status and resource
+ * usage. Its heap is whatever the shell had when it was started, which
+ * is why main() starts it before loading the environment and history.
+ * Return: 0 if the fork-server is running, -1 on failure
+ */
+int start_fork_server(info_t *info)
+{
+	int sv[2], fds[3], i;
+	srvreq_t req;
+	srvreply_t reply;
+	char *msg;
+	pid_t pid;
+
+	if (info->server_fd)
+		return (0);
+	if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) == -1)
+		return (-1);
+	info->server_pid = fork();
+	if (info->server_pid == -1)
+		return (close(sv[0]), close(sv[1]), -1);
+	if (info->server_pid > 0)
+		return (close(sv[1]), info->server_fd = sv[0], 0);
+	close(sv[0]);
+	if (info->readfd > 2)
+		close(info->readfd);
+	signal(SIGINT, SIG_IGN);
+	signal(SIGQUIT, SIG_IGN);
+	signal(SIGCHLD, SIG_DFL);
+	while ((msg = recv_request(sv[1], &req, fds)))
+	{
+		_memset((void *)&reply, 0, sizeof(reply));
+		pid = fork();
+		if (pid == 0)
+			server_child(msg, &req, fds);
+		for (i = 0; i < 3; i++)
+			close(fds[i]);
+		free(msg);
+		if (pid == -1 || wait4(pid, &reply.status, 0, &reply.ru) == -1)
+			reply.status = 1 << 8;
+		if (write(sv[1], &reply, sizeof(reply)) !=
+			(ssize_t)sizeof(reply))
+			break;
+	}
+	_exit(0);
+}
+
+/**
+ * server_cmd - launches info->path through the fork-server
+ * @info: holds all the shell state and command information
+ *
+ * The launch costs the same however large the shell's heap grows,
+ * since only the small fork-server ever forks.
+ * Return: 0 once the command has run, -1 if the fork-server is not
+ * usable and the caller should launch the command itself
+ */
+int server_cmd(info_t *info)
+{
+	srvreq_t req;
+	srvreply_t reply;
+	char *msg;
+
+	if (start_fork_server(info) == -1)
+		return (-1);
+	msg = pack_request(info, &req);
+	if (!msg)
+		return (-1);
+	if (send_request(info->server_fd, &req, msg) ||
+		read_full(info->server_fd, &reply, sizeof(reply)))
+	{
+		free(msg);
+		stop_fork_server(info);
+		return (-1);
+	}
+	free(msg);
+	info->status = reply.status;
+	finish_cmd(info, &reply.ru);
+	return (0);
+}
+
+/**
+ * stop_fork_server - shuts the fork-server down
+ * @info: the shell state structure
+ *
+ * Closing the socket makes the fork-server exit; it is then reaped.
+ */
+void stop_fork_server(info_t *info)
+{
+	if (!info->server_fd)
+		return;
+	close(info->server_fd);
+	waitpid(info->server_pid, NULL, 0);
+	info->server_fd = 0;
+}
@@ -0,0 +1,130 @@
+#include "shell.h"
+
+/**
+ * read_full - reads exactly len bytes from a file descriptor
+ * @fd: the file descriptor to read from
+ * @buf: the buffer to fill
+ * @len: the number of bytes wanted
+ *
+ * Return: 0 on success, -1 on error or end of file
+ */
+int read_full(int fd, void *buf, size_t len)
+{
+	size_t off = 0;
+	ssize_t n;
+
+	while (off < len)
+	{
+		n = read(fd, (char *)buf + off, len - off);
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return (-1);
+		off += n;
+	}
+	return (0);
+}
+
+/**
+ * write_all - writes a whole buffer to a file descriptor
+ * @fd: the file descriptor
+ * @buf: the buffer
+ * @len: its length
+ *
+ * Return: 0 on success, -1 on error
+ */
+int write_all(int fd, void *buf, size_t len)
+{
+	size_t off;
+	ssize_t n;
+
+	for (off = 0; off < len; off += n)
+	{
+		n = write(fd, (char *)buf + off, len - off);
+		if (n == -1 && errno == EINTR)
+			n = 0;
+		else if (n <= 0)
+			return (-1);
+	}
+	return (0);
+}
+
+/**
+ * pack_request - builds the payload of a fork-server launch request
+ * @info: holds info->path and info->argv of the command to launch
+ * @req: the request header, filled in here
+ *
+ * Return: the malloc'd payload of req->len bytes, or NULL on failure
+ */
+char *pack_request(info_t *info, srvreq_t *req)
+{
+	char cwd[PATH_MAX], **envp = get_environ(info), *msg, *p;
+	int i;
+
+	if (!getcwd(cwd, sizeof(cwd)))
+		cwd[0] = 0;
+	req->len = _strlen(cwd) + _strlen(info->path) + 2;
+	for (req->argc = 0; info->argv[req->argc]; req->argc++)
+		req->len += _strlen(info->argv[req->argc]) + 1;
+	for (req->envc = 0; envp && envp[req->envc]; req->envc++)
+		req->len += _strlen(envp[req->envc]) + 1;
+	msg = malloc(req->len);
+	if (!msg)
+		return (NULL);
+	_strcpy(msg, cwd);
+	p = msg + _strlen(cwd) + 1;
+	_strcpy(p, info->path);
+	p += _strlen(p) + 1;
+	for (i = 0; i < req->argc; p += _strlen(p) + 1)
+		_strcpy(p, info->argv[i++]);
+	for (i = 0; i < req->envc; p += _strlen(p) + 1)
+		_strcpy(p, envp[i++]);
+	return (msg);
+}
+
+/**
+ * send_request - sends a launch request to the fork-server
+ * @sock: the socket connected to the fork-server
+ * @req: the request header
+ * @msg: the payload of req->len bytes
+ *
+ * The header carries the shell's current stdin, stdout and stderr so
+ * the command gets the same descriptors a forked child would.
+ * Return: 0 on success, -1 if the fork-server is gone
+ */
+int send_request(int sock, srvreq_t *req, char *msg)
+{
+	struct msghdr mh;
+	struct iovec iov;
+	struct cmsghdr *cm;
+	char ctl[CMSG_SPACE(sizeof(int) * 3)];
+	size_t off;
+	ssize_t n;
+	int i;
+
+	_memset((void *)&mh, 0, sizeof(mh));
+	_memset(ctl, 0, sizeof(ctl));
+	iov.iov_base = req;
+	iov.iov_len = sizeof(*req);
+	mh.msg_iov = &iov;
+	mh.msg_iovlen = 1;
+	mh.msg_control = ctl;
+	mh.msg_controllen = sizeof(ctl);
+	cm = CMSG_FIRSTHDR(&mh);
+	cm->cmsg_level = SOL_SOCKET;
+	cm->cmsg_type = SCM_RIGHTS;
+	cm->cmsg_len = CMSG_LEN(sizeof(int) * 3);
+	for (i = 0; i < 3; i++)
+		((int *)CMSG_DATA(cm))[i] = i;
+	if (sendmsg(sock, &mh, MSG_NOSIGNAL) != (ssize_t)sizeof(*req))
+		return (-1);
+	for (off = 0; off < req->len; off += n)
+	{
+		n = send(sock, msg + off, req->len - off, MSG_NOSIGNAL);
+		if (n == -1 && errno == EINTR)
+			n = 0;
+		else if (n <= 0)
+			return (-1);
+	}
+	return (0);
+}
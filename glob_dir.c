@@ -0,0 +1,123 @@
+#include "shell.h"
+
+/**
+ * dir_read - reads the entries of a directory into a listing
+ * @d: the listing, whose names are filled in
+ * @path: the directory
+ *
+ * The entries are read with getdents64() in batches of
+ * GLOB_DIRBUF_SIZE bytes, so even a huge directory takes only a few
+ * system calls, and are copied with their d_type so directories can be
+ * told apart without a stat() of every entry.
+ * Return: 0 on success, -1 if the directory cannot be read or memory
+ * ran out
+ */
+static int dir_read(globdir_t *d, char *path)
+{
+	int fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	char *buf = fd == -1 ? NULL : malloc(GLOB_DIRBUF_SIZE), *p;
+	size_t cap = 0, n;
+	ssize_t got = 1, off;
+	struct dirent64 *e;
+
+	while (got > 0 && buf &&
+		(got = getdents64(fd, buf, GLOB_DIRBUF_SIZE)) > 0)
+		for (off = 0; off < got; off += e->d_reclen)
+		{
+			e = (struct dirent64 *)(buf + off);
+			n = _strlen(e->d_name) + 2;
+			if (e->d_name[0] == '.' && (!e->d_name[1] ||
+				(e->d_name[1] == '.' && !e->d_name[2])))
+				continue;
+			if (d->len + n > cap)
+			{
+				while (d->len + n > cap)
+					cap = cap ? cap * 2 : 4096;
+				p = realloc(d->names, cap);
+				if (!p)
+				{
+					got = -1;
+					break;
+				}
+				d->names = p;
+			}
+			d->names[d->len] = e->d_type;
+			_strcpy(d->names + d->len + 1, e->d_name);
+			d->len += n;
+		}
+	free(buf);
+	if (fd != -1)
+		close(fd);
+	return (got == 0 ? 0 : -1);
+}
+
+/**
+ * glob_dir - gives the listing of a directory, reading it if need be
+ * @info: the shell state, whose glob_cache keeps the listings
+ * @path: the directory
+ *
+ * Listings are kept until the command line is done and looked up by
+ * inode; a listing is only used while the directory's modification
+ * time is the one it was read at, so a directory changed by an earlier
+ * command of the line is read again. A stale listing stays in its
+ * bucket behind the new one, as a pattern may still be walking it.
+ * Return: the listing, NULL if @path is no readable directory or
+ * memory ran out
+ */
+globdir_t *glob_dir(info_t *info, char *path)
+{
+	struct stat st;
+	globdir_t *d, **b;
+
+	if (stat(path, &st) == -1 || !S_ISDIR(st.st_mode))
+		return (NULL);
+	if (!info->glob_cache)
+	{
+		info->glob_cache = malloc(sizeof(globdir_t *) * GLOB_HASH_SIZE);
+		if (!info->glob_cache)
+			return (NULL);
+		_memset((void *)info->glob_cache, 0,
+			sizeof(globdir_t *) * GLOB_HASH_SIZE);
+	}
+	b = &info->glob_cache[st.st_ino % GLOB_HASH_SIZE];
+	for (d = *b; d; d = d->next)
+		if (d->ino == st.st_ino && d->dev == st.st_dev)
+			break;
+	if (d && d->mtime.tv_sec == st.st_mtim.tv_sec &&
+		d->mtime.tv_nsec == st.st_mtim.tv_nsec)
+		return (d);
+	d = malloc(sizeof(globdir_t));
+	if (!d)
+		return (NULL);
+	_memset((void *)d, 0, sizeof(globdir_t));
+	d->dev = st.st_dev;
+	d->ino = st.st_ino;
+	d->mtime = st.st_mtim;
+	d->next = *b;
+	*b = d;
+	if (dir_read(d, path) == 0)
+		return (d);
+	*b = d->next;
+	free(d->names);
+	free(d);
+	return (NULL);
+}
+
+/**
+ * glob_clear - drops the directory listings of the command line
+ * @info: the shell state structure
+ */
+void glob_clear(info_t *info)
+{
+	globdir_t *d, *next;
+	int i;
+
+	for (i = 0; info->glob_cache && i < GLOB_HASH_SIZE; i++)
+		for (d = info->glob_cache[i]; d; d = next)
+		{
+			next = d->next;
+			free(d->names);
+			free(d);
+		}
+	bfree((void **)&info->glob_cache);
+}
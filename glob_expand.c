@@ -0,0 +1,112 @@
+#include "shell.h"
+
+/**
+ * glob_cmp - orders two matches the way sh sorts them
+ * @a: points to the first match
+ * @b: points to the second match
+ *
+ * Return: less than, equal to or greater than 0, as strcmp()
+ */
+static int glob_cmp(const void *a, const void *b)
+{
+	return (strcmp(*(char **)a, *(char **)b));
+}
+
+/**
+ * glob_walk - expands the pattern from one segment on
+ * @info: the shell state, whose xbuf collects the matches
+ * @g: the pattern
+ * @seg: the first op of the segment
+ * @path: the path matched so far, ending in a / unless it is empty;
+ * PATH_MAX bytes
+ * @len: its length
+ *
+ * A segment without wildcards is taken as it is, and the path is only
+ * checked to exist at the end. A segment with wildcards is matched
+ * against the directory's cached listing, where only directories lead
+ * on to the next segment; names starting with a . need the segment to
+ * start with one too.
+ * Return: the number of matches, -1 if memory ran out
+ */
+static int glob_walk(info_t *info, globpat_t *g, unsigned short *seg,
+	char *path, size_t len)
+{
+	unsigned short *e = seg;
+	int wild = 0, n = 0, r = 0;
+	globdir_t *d;
+	struct stat st;
+	size_t k = len;
+	char *p;
+
+	for (; *e != GLOB_SEP && *e != GLOB_END; e++)
+		wild |= *e >= GLOB_ANY;
+	for (; !wild && seg < e && k < PATH_MAX - 2; seg++)
+		path[k++] = *seg;
+	path[k] = 0;
+	if (!wild)
+	{
+		if (*e == GLOB_END && lstat(path, &st))
+			return (0);
+		if (*e == GLOB_END)
+			return (xbuf_put(info, path, k + 1) ? -1 : 1);
+		path[k] = '/';
+		return (glob_walk(info, g, e + 1, path, k + 1));
+	}
+	d = glob_dir(info, len ? path : ".");
+	for (p = d ? d->names : NULL; p && p < d->names + d->len && r != -1;
+		p += _strlen(p + 1) + 2, n += r)
+	{
+		k = len + _strlen(p + 1);
+		r = 0;
+		if ((p[1] == '.' && *seg != '.') || k + 2 >= PATH_MAX ||
+			!glob_match(seg, p + 1, g->cls))
+			continue;
+		_strcpy(path + len, p + 1);
+		if (*e == GLOB_END)
+			r = xbuf_put(info, path, k + 1) ? -1 : 1;
+		else if (*p == DT_DIR || *p == DT_LNK || *p == DT_UNKNOWN)
+		{
+			path[k] = '/';
+			r = glob_walk(info, g, e + 1, path, k + 1);
+		}
+	}
+	return (r == -1 ? -1 : n);
+}
+
+/**
+ * glob_word - expands a word as a pathname pattern
+ * @info: the shell state structure
+ * @s: the word
+ * @len: its length
+ * @quoted: on if @s is the word as it stands in the command line, off
+ * if it is the result of an expansion, see glob_compile()
+ *
+ * On a match, xbuf holds the matching paths, sorted and separated by
+ * null bytes, with xlen at the null byte that ends the last one.
+ * Return: the number of matches, 0 if the word is no pattern or
+ * matches nothing, -1 if memory ran out
+ */
+int glob_word(info_t *info, char *s, size_t len, int quoted)
+{
+	char path[PATH_MAX], **v, *w;
+	globpat_t g;
+	int n = glob_compile(info, s, len, quoted, &g), i;
+
+	if (n <= 0)
+		return (n);
+	info->xlen = 0;
+	n = glob_walk(info, &g, g.ops, path, 0);
+	if (n <= 0)
+		return (n);
+	v = arena_alloc(info, sizeof(char *) * n + info->xlen);
+	if (!v)
+		return (-1);
+	for (i = 0, w = info->xbuf; i < n; w += _strlen(w) + 1)
+		v[i++] = w;
+	qsort(v, n, sizeof(char *), glob_cmp);
+	for (i = 0, w = (char *)(v + n); i < n; i++)
+		w = _strcpy(w, v[i]) + _strlen(v[i]) + 1;
+	memcpy(info->xbuf, (char *)(v + n), info->xlen);
+	info->xlen--;
+	return (n);
+}
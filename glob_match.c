@@ -0,0 +1,130 @@
+#include "shell.h"
+
+/**
+ * glob_class - compiles a bracket expression into a byte table
+ * @s: the text right after the [
+ * @end: the end of the pattern
+ * @tab: the 256-bit table to fill in
+ *
+ * Handles ranges, ! or ^ for the complement, and a ] first in the list
+ * standing for itself. A / ends the pattern's segment, so a [ that is
+ * not closed before one is an ordinary character.
+ * Return: the text after the closing ], NULL if there is none
+ */
+static char *glob_class(char *s, char *end, unsigned char *tab)
+{
+	int neg = s < end && (*s == '!' || *s == '^'), c, k;
+	char *p = s + neg;
+
+	_memset((char *)tab, 0, 32);
+	for (; p < end && *p != '/' && (*p != ']' || p == s + neg); p++)
+	{
+		c = (unsigned char)*p;
+		k = c;
+		if (p + 2 < end && p[1] == '-' && p[2] != ']')
+		{
+			k = (unsigned char)p[2];
+			p += 2;
+		}
+		for (; c <= k; c++)
+			tab[c >> 3] |= 1 << (c & 7);
+	}
+	if (p >= end || *p != ']')
+		return (NULL);
+	for (k = 0; neg && k < 32; k++)
+		tab[k] = ~tab[k];
+	return (p + 1);
+}
+
+/**
+ * glob_compile - compiles a word into a pathname pattern
+ * @info: the shell state, whose arena holds the result
+ * @s: the word
+ * @len: its length
+ * @quoted: on if @s is a word as it stands in the command line, whose
+ * quotes and backslashes make what they quote literal; off for the
+ * result of an expansion, where they are ordinary characters
+ * @g: the pattern to fill in
+ *
+ * The pattern is compiled once per word, so matching it against every
+ * name in a directory never looks at the word's text again.
+ * Return: the number of wildcards, 0 if the word is no pattern at all,
+ * -1 if memory ran out
+ */
+int glob_compile(info_t *info, char *s, size_t len, int quoted,
+	globpat_t *g)
+{
+	char *end = s + len, *e, q = 0;
+	unsigned short *op;
+	int wild = 0, k = 0;
+
+	for (e = s; e < end; e++)
+		k += *e == '[';
+	g->ops = arena_alloc(info, sizeof(unsigned short) * (len + 1));
+	g->cls = k ? arena_alloc(info, 32 * k) : NULL;
+	if (!g->ops || (k && !g->cls))
+		return (-1);
+	for (op = g->ops, k = 0; s < end; s++)
+		if (quoted && (q ? *s == q : *s == '\'' || *s == '"'))
+			q = q ? 0 : *s;
+		else if (quoted && q != '\'' && *s == '\\' && s + 1 < end &&
+			(!q || _strchr("\\$`\"", s[1])))
+			*op++ = (unsigned char)*++s;
+		else if (*s == '/')
+			*op++ = GLOB_SEP;
+		else if (q || (*s != '*' && *s != '?' && *s != '[') ||
+			(*s == '[' && !(e = glob_class(s + 1, end, g->cls[k]))))
+			*op++ = (unsigned char)*s;
+		else
+		{
+			*op++ = *s == '*' ? GLOB_STAR : *s == '?' ? GLOB_ANY
+				: GLOB_CLASS + k++;
+			s = *s == '[' ? e - 1 : s;
+			wild++;
+		}
+	*op = GLOB_END;
+	return (wild);
+}
+
+/**
+ * glob_match - matches a name against one segment of a pattern
+ * @op: the first op of the segment
+ * @name: the name
+ * @cls: the pattern's bracket expressions
+ *
+ * A * first matches nothing and takes one more character each time
+ * what follows it fails, going back only to the last *, so a match
+ * never takes more than a pass per * over the name.
+ * Return: 1 if the name matches, 0 otherwise
+ */
+int glob_match(unsigned short *op, char *name, unsigned char (*cls)[32])
+{
+	unsigned short *star = NULL;
+	char *back = NULL;
+	unsigned char c;
+
+	while (*name)
+	{
+		c = (unsigned char)*name;
+		if (*op == GLOB_STAR)
+		{
+			star = ++op;
+			back = name;
+			continue;
+		}
+		if (*op == c || *op == GLOB_ANY || (*op >= GLOB_CLASS &&
+			IN_TABLE(cls[*op - GLOB_CLASS], c)))
+		{
+			op++;
+			name++;
+			continue;
+		}
+		if (!star)
+			return (0);
+		op = star;
+		name = ++back;
+	}
+	while (*op == GLOB_STAR)
+		op++;
+	return (*op == GLOB_SEP || *op == GLOB_END);
+}
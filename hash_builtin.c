@@ -0,0 +1,76 @@
+#include "shell.h"
+
+/**
+ * print_cmd_hash - prints the remembered command locations
+ * @info: structure containing shell state, including the cache
+ *
+ * Return: the number of entries printed
+ */
+int print_cmd_hash(info_t *info)
+{
+	cmdhash_t *entry;
+	int i, j, n = 0;
+	char *num;
+
+	for (i = 0; info->cmd_hash && i < CMD_HASH_SIZE; i++)
+		for (entry = info->cmd_hash[i]; entry; entry = entry->next)
+		{
+			if (!entry->path)
+				continue;
+			if (!n++)
+				_puts("hits\tcommand\n");
+			num = convert_number(entry->hits, 10, 0);
+			for (j = _strlen(num); j < 4; j++)
+				_putchar(' ');
+			_puts(num);
+			_putchar('\t');
+			_puts(entry->path);
+			_putchar('\n');
+		}
+	return (n);
+}
+
+/**
+ * _myhash - mimics the hash builtin (man bash)
+ * @info: Structure containing potential arguments. Used to maintain
+ *          constant function prototype.
+ *
+ * With no arguments lists the cached command locations, -r empties
+ * the cache, and each name given is looked up and remembered. The
+ * status is 1 if a name could not be found, 0 otherwise.
+ * Return: 0 on success, 1 if a name could not be found
+ */
+int _myhash(info_t *info)
+{
+	int i, ret = 0;
+	char *path;
+
+	if (info->argc == 1)
+	{
+		if (!print_cmd_hash(info))
+			_eputs("hash: hash table empty\n");
+		info->status = 0;
+		return (0);
+	}
+	for (i = 1; info->argv[i]; i++)
+	{
+		if (!_strcmp(info->argv[i], "-r"))
+		{
+			cmd_hash_clear(info);
+			continue;
+		}
+		if (_strchr(info->argv[i], '/'))
+			continue;
+		path = find_path(info, _getenv(info, "PATH="), info->argv[i]);
+		if (!path)
+		{
+			ret = 1;
+			print_error(info, info->argv[i]);
+			_eputs(": not found\n");
+			continue;
+		}
+		cmd_hash_store(info, info->argv[i], path);
+	}
+	info->status = ret;
+	return (ret);
+}
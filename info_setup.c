@@ -15,6 +15,9 @@ void clear_info(info_t *info)
 	info->argv = NULL;
 	info->path = NULL;
 	info->argc = 0;
+	info->tail_ok = 0;
+	info->cmd_toks = NULL;
+	info->cmd_ntok = 0;
 }
 
 /**
@@ -25,24 +28,26 @@ void clear_info(info_t *info)
  *
  * This function initializes the info_t structure with the
  * filename and processes any arguments
- * Return: present in the info->arg field by tokenizing them into
- * info->argv and performing variable and alias replacement.
+ * present in the info->cmd_toks field by tokenizing them into
+ * info->argv and performing variable and alias replacement. A command
+ * whose words cannot be expanded is left with none.
+ * Return: 0 on success, -1 if an expansion failed
  */
-void set_info(info_t *info, char **av)
+int set_info(info_t *info, char **av)
 {
 	int i = 0;
 
 	info->fname = av[0];
 	if (info->arg)
 	{
-		info->argv = strtow(info->arg, " \t");
+		info->argv = tokenize(info, info->cmd_toks, info->cmd_ntok);
 		if (!info->argv)
 		{
 
-			info->argv = malloc(sizeof(char *) * 2);
+			info->argv = arena_alloc(info, sizeof(char *) * 2);
 			if (info->argv)
 			{
-				info->argv[0] = _strdup(info->arg);
+				info->argv[0] = arena_dup(info, info->arg);
 				info->argv[1] = NULL;
 			}
 		}
@@ -50,9 +55,15 @@ void set_info(info_t *info, char **av)
 			;
 		info->argc = i;
 
+		if (info->argv && replace_vars(info))
+		{
+			info->argv[0] = NULL;
+			info->argc = 0;
+			return (-1);
+		}
 		replace_alias(info);
-		replace_vars(info);
 	}
+	return (0);
 }
 
 /**
@@ -67,24 +78,37 @@ void set_info(info_t *info, char **av)
  */
 void free_info(info_t *info, int all)
 {
-	ffree(info->argv);
+	arena_reset(info);
 	info->argv = NULL;
 	info->path = NULL;
 	if (all)
 	{
-		if (!info->cmd_buf)
+		if (!info->cmd_buf && !info->prog)
 			free(info->arg);
-		if (info->env)
-			free_list(&(info->env));
+		local_free(info);
+		env_free(info);
 		if (info->history)
 			free_list(&(info->history));
+		alias_clear(info);
+		glob_clear(info);
+		arith_clear(info);
 		if (info->alias)
 			free_list(&(info->alias));
-		ffree(info->environ);
-			info->environ = NULL;
-		bfree((void **)info->cmd_buf);
+		stop_fork_server(info);
+		free_jobs(info);
+		cmd_hash_clear(info);
+		bfree((void **)&info->cmd_hash);
+		bfree((void **)&info->tok_buf);
+		bfree((void **)&info->node_buf);
+		bfree((void **)&info->xbuf);
+		if (!info->src)
+			bfree((void **)info->cmd_buf);
+		unmap_script(info);
+		free_program(info);
+		arena_free(info);
 		if (info->readfd > 2)
 			close(info->readfd);
 		_putchar(BUF_FLUSH);
+		_eputchar(BUF_FLUSH);
 	}
 }
@@ -1,98 +1,90 @@
 #include "shell.h"
 
 /**
- * input_buf - processes chained commands from input buffer
+ * input_buf - reads the next line of input
  * @info: pointer to the shell info structure
- * @buf: address of input buffer containing command chain
- * @len: address of length variable tracking the buffer size
+ * @buf: address of the line buffer, which is reused
+ * @len: the length of the text in *buf the line runs on from, 0 for
+ * a new line
  *
- * Manages the parsing and execution of chained commands read
- * into the input buffer.
- * Handles input retrieval, command separation, and history logging.
- * Return: the number of bytes processed.
+ * The line is recorded in the history as it was typed. A line read
+ * to complete the text in *buf is appended to it after a newline; in
+ * memory the two are already next to each other, so only the newline
+ * input_buf() took off the first has to be put back.
+ * Return: the length of the text in *buf, -1 at end of input
  */
-ssize_t input_buf(info_t *info, char **buf, size_t *len)
+static ssize_t input_buf(info_t *info, char **buf, size_t len)
 {
+	static size_t cap, more_cap; /* the sizes of *buf and more */
+	static char *more; /* the buffer a line that runs on is read into */
+	char **line = len ? &more : buf;
 	ssize_t r = 0;
-	size_t len_p = 0;
 
-	if (!*len) /* if nothing left in the buffer, fill it */
-	{
-		/*bfree((void **)info->cmd_buf);*/
-		free(*buf);
-		*buf = NULL;
-		signal(SIGINT, sigintHandler);
+	signal(SIGINT, sigintHandler);
 #if USE_GETLINE
-		r = getline(buf, &len_p, stdin);
+	r = getline(line, len ? &more_cap : &cap, stdin);
 #else
-		r = _getline(info, buf, &len_p);
+	r = _getline(info, line, len ? &more_cap : &cap);
 #endif
-		if (r > 0)
-		{
-			if ((*buf)[r - 1] == '\n')
-			{
-				(*buf)[r - 1] = '\0'; /* remove trailing newline */
-				r--;
-			}
-			info->linecount_flag = 1;
-			remove_comments(*buf);
-			build_history_list(info, *buf, info->histcount++);
-			/* if (_strchr(*buf, ';')) is this a command chain? */
-			{
-				*len = r;
-				info->cmd_buf = buf;
-			}
-		}
+	if (r <= 0)
+		return (-1);
+	if ((*line)[r - 1] == '\n')
+		(*line)[--r] = '\0'; /* remove trailing newline */
+	info->linecount_flag = 1;
+	info->cmd_buf = buf;
+	build_history_list(info, *line, info->histcount++);
+	if (len && !info->src)
+	{
+		if (grow_line(buf, &cap, len + r + 2) == -1)
+			return (-1);
+		memcpy(*buf + len + 1, more, r + 1);
 	}
-	return (r);
+	if (len)
+		(*buf)[len] = '\n';
+	return (len ? (ssize_t)len + 1 + r : r);
 }
 
 /**
- * get_input - retrieves and processes a single command or a chain of commands
+ * get_input - retrieves the next command line to run
  * @info: pointer to the shell info structure
  *
- * Coordinates the retrieval of input lines and manages command
- * chaining by checking for semicolons.
- * Handles command history and buffer management.
- * Return: the length of the command to be executed.
+ * Lines come from the compiled script if there is one, else they are
+ * read and parsed; a line that leaves a quote, group or operator open
+ * runs on to the next one, prompted for with "> ". A syntax error is
+ * reported here.
+ * Return: the root node of the line's tree, PARSE_NONE if there is
+ * nothing to run, PARSE_ERR or -1 after an error, -1 at end of input
  */
-ssize_t get_input(info_t *info)
+int get_input(info_t *info)
 {
-	static char *buf; /* the ';' command chain buffer */
-	static size_t i, j, len;
-	ssize_t r = 0;
-	char **buf_p = &(info->arg), *p;
+	static char *buf; /* the line buffer */
+	ssize_t len = 0;
+	int r = PARSE_MORE;
 
 	_putchar(BUF_FLUSH);
-	r = input_buf(info, &buf, &len);
-	if (r == -1) /* EOF */
-		return (-1);
-	if (len)	/* we have commands left in the chain buffer */
+	if (info->prog)
+		return (prog_input(info));
+	info->line = NULL;
+	while (r == PARSE_MORE || r == LEX_OPEN)
 	{
-		j = i; /* init new iterator to current buf position */
-		p = buf + i; /* get pointer for return */
-
-		check_chain(info, buf, &j, i, len);
-		while (j < len) /* iterate to semicolon or end */
+		if (len && interactive(info))
 		{
-			if (is_chain(info, buf, &j))
-				break;
-			j++;
+			_puts("> ");
+			_putchar(BUF_FLUSH);
 		}
-
-		i = j + 1; /* increment past nulled ';'' */
-		if (i >= len) /* reached end of buffer? */
+		len = input_buf(info, &buf, len);
+		if (len == -1)
 		{
-			i = len = 0; /* reset position and length */
-			info->cmd_buf_type = CMD_NORM;
+			if (info->line)
+				parse_error(info, r);
+			return (-1);
 		}
-
-		*buf_p = p; /* pass back pointer to current command position */
-		return (_strlen(p)); /* return length of current command */
+		info->line = buf;
+		r = parse_line(info);
 	}
-
-	*buf_p = buf; /* else not a chain, pass back buffer from _getline() */
-	return (r); /* return length of buffer from _getline() */
+	if (r == PARSE_ERR || r == -1)
+		parse_error(info, r);
+	return (r);
 }
 
 /**
@@ -101,17 +93,27 @@ ssize_t get_input(info_t *info)
  * @buf: buffer to read into
  * @i: current position in buffer
  *
- * This function reads input into a buffer from a file descriptor
- * specified in info.
+ * A regular file, or anything else that can seek, and a terminal, which
+ * hands out one line per read, are read READ_BLOCK_SIZE bytes at a
+ * time. A pipe is read a byte at a time, so that nothing past the line
+ * is taken from a command run on it that reads its stdin too.
  * Return: the number of bytes read or -1 on error.
  */
 ssize_t read_buf(info_t *info, char *buf, size_t *i)
 {
+	static int fd = -1;
+	static size_t unit;
 	ssize_t r = 0;
 
 	if (*i)
 		return (0);
-	r = read(info->readfd, buf, READ_BUF_SIZE);
+	if (info->readfd != fd)
+	{
+		fd = info->readfd;
+		unit = lseek(fd, 0, SEEK_CUR) != -1 || isatty(fd) ?
+			READ_BLOCK_SIZE : 1;
+	}
+	r = read(info->readfd, buf, unit);
 	if (r >= 0)
 		*i = r;
 	return (r);
@@ -121,50 +123,47 @@ ssize_t read_buf(info_t *info, char *buf, size_t *i)
  * _getline - retrieves a line of input from a file descriptor
  * @info: pointer to the shell info structure containing file
  * descriptor for input
- * @ptr: address of pointer to buffer, to store the input line
- * @length: size of preallocated buffer if not NULL
+ * @ptr: address of the line buffer, reused from call to call
+ * @size: address of the size of the line buffer
  *
- * Reads input until a newline or EOF is encountered. It manages
- * a static buffer to
- * keep track of the input state across multiple calls.
- * Return: the length of the line read.
+ * Reads input until a newline or EOF is encountered, a block at a time
+ * as read_buf() sees fit. It manages a static buffer to
+ * keep track of the input state across multiple calls, finds the
+ * newline with memchr() and carries on with the next block when a
+ * line crosses the end of one. The line, newline included, is
+ * null-terminated in *ptr, which grows as needed and is the caller's
+ * to free once reading is over.
+ * Return: the length of the line read, -1 at end of input.
  */
-int _getline(info_t *info, char **ptr, size_t *length)
+int _getline(info_t *info, char **ptr, size_t *size)
 {
-	static char buf[READ_BUF_SIZE];
+	static char buf[READ_BLOCK_SIZE];
 	static size_t i, len;
-	size_t k;
-	ssize_t r = 0, s = 0;
-	char *p = NULL, *new_p = NULL, *c;
-
-	p = *ptr;
-	if (p && length)
-		s = *length;
-	if (i == len)
-		i = len = 0;
+	size_t s = 0, k;
+	ssize_t r;
+	char *c = NULL;
 
-	r = read_buf(info, buf, &len);
-	if (r == -1 || (r == 0 && len == 0))
+	if (info->src)
+		return (src_getline(info, ptr));
+	while (!c)
+	{
+		if (i == len)
+			i = len = 0;
+		r = read_buf(info, buf, &len);
+		if (r == -1 || (r == 0 && len == 0))
+			break;
+		c = memchr(buf + i, '\n', len - i);
+		k = (c ? (size_t)(c - buf) + 1 : len) - i;
+		if (grow_line(ptr, size, s + k + 1) == -1)
+			return (-1);
+		memcpy(*ptr + s, buf + i, k);
+		s += k;
+		i += k;
+	}
+	info->read_pending = len - i;
+	if (!s)
 		return (-1);
-
-	c = _strchr(buf + i, '\n');
-	k = c ? 1 + (unsigned int)(c - buf) : len;
-	new_p = _realloc(p, s, s ? s + k : k + 1);
-	if (!new_p) /* MALLOC FAILURE! */
-		return (p ? free(p), -1 : -1);
-
-	if (s)
-		_strncat(new_p, buf + i, k - i);
-	else
-		_strncpy(new_p, buf + i, k - i + 1);
-
-	s += k - i;
-	i = k;
-	p = new_p;
-
-	if (length)
-		*length = s;
-	*ptr = p;
+	(*ptr)[s] = 0;
 	return (s);
 }
 
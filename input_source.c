@@ -0,0 +1,28 @@
+#include "shell.h"
+
+/**
+ * src_getline - retrieves a line of input from info->src
+ * @info: pointer to the shell info structure holding the input
+ * @ptr: set to the start of the line inside info->src
+ *
+ * Works like _getline() on a file descriptor, for input the shell
+ * already holds in memory: a -c command string, a mapped script or
+ * one script line given to a parallel worker. Nothing is copied: the line is
+ * handed out in place and ends with its newline, which input_buf()
+ * overwrites, or with the terminator of info->src. The caller must not
+ * free it.
+ * Return: the length of the line read, -1 once src is exhausted
+ */
+int src_getline(info_t *info, char **ptr)
+{
+	char *start = info->src + info->src_pos, *c;
+	size_t k;
+
+	if (info->src_pos >= info->src_len)
+		return (-1);
+	c = memchr(start, '\n', info->src_len - info->src_pos);
+	k = c ? (size_t)(c - start) + 1 : info->src_len - info->src_pos;
+	*ptr = start;
+	info->src_pos += k;
+	return (k);
+}
@@ -0,0 +1,152 @@
+#include "shell.h"
+
+/**
+ * give_terminal - hands the controlling terminal to a process group
+ * @info: the shell state structure
+ * @pgid: the process group to put in the foreground
+ *
+ * Only an interactive shell owns a terminal. SIGTTOU is ignored for
+ * the call so the shell is not stopped while it is in the background.
+ */
+static void give_terminal(info_t *info, pid_t pgid)
+{
+	if (!interactive(info))
+		return;
+	signal(SIGTTOU, SIG_IGN);
+	tcsetpgrp(STDIN_FILENO, pgid);
+	signal(SIGTTOU, SIG_DFL);
+}
+
+/**
+ * _myjobs - lists the background jobs (man jobs)
+ * @info: Structure containing potential arguments. Used to maintain
+ *          constant function prototype.
+ *
+ * Finished jobs are listed once and then forgotten.
+ * Return: Always 0
+ */
+int _myjobs(info_t *info)
+{
+	int id, i, max = 0;
+
+	reap_jobs(info, 1);
+	for (i = 0; info->jobs && i < JOBS_MAX; i++)
+		if (info->jobs[i].id > max)
+			max = info->jobs[i].id;
+	for (id = 1; id <= max; id++)
+		for (i = 0; i < JOBS_MAX; i++)
+			if (info->jobs[i].id == id)
+				print_job(info, &info->jobs[i]);
+	for (i = 0; info->jobs && i < JOBS_MAX; i++)
+		if (info->jobs[i].state == JOB_DONE)
+			free_job(&info->jobs[i]);
+	return (0);
+}
+
+/**
+ * _mywait - waits for background jobs (man wait)
+ * @info: Structure containing potential arguments. Used to maintain
+ *          constant function prototype.
+ *
+ * With no operand waits for every job and sets the status to 0,
+ * otherwise waits for each job or pid given and sets the status to
+ * that of the last one, 127 if it is not a job of this shell.
+ * Return: Always 0
+ */
+int _mywait(info_t *info)
+{
+	job_t *job;
+	int i;
+
+	info->status = 0;
+	for (i = 0; info->argc == 1 && info->jobs && i < JOBS_MAX; i++)
+		if (info->jobs[i].id)
+		{
+			wait_job(&info->jobs[i]);
+			if (info->jobs[i].state == JOB_DONE)
+				free_job(&info->jobs[i]);
+		}
+	for (i = 1; info->argv[i]; i++)
+	{
+		job = find_job(info, info->argv[i]);
+		if (!job)
+		{
+			info->status = 127;
+			print_error(info, info->argv[i]);
+			_eputs(": no such job\n");
+			continue;
+		}
+		info->status = wait_job(job);
+		if (job->state == JOB_DONE)
+			free_job(job);
+	}
+	return (0);
+}
+
+/**
+ * _myfg - resumes a job in the foreground (man fg)
+ * @info: Structure containing potential arguments. Used to maintain
+ *          constant function prototype.
+ *
+ * The status is that of the job, 1 if there is no such job.
+ * Return: 0 on success, 1 if there is no such job
+ */
+int _myfg(info_t *info)
+{
+	job_t *job = find_job(info, info->argv[1]);
+
+	if (!job)
+	{
+		print_error(info, info->argv[1] ? info->argv[1] : "current");
+		_eputs(": no such job\n");
+		info->status = 1;
+		return (1);
+	}
+	_puts(job->cmd);
+	_putchar('\n');
+	_putchar(BUF_FLUSH);
+	give_terminal(info, job->pgid);
+	if (job->state == JOB_STOPPED)
+		kill(-job->pgid, SIGCONT);
+	if (job->state != JOB_DONE)
+		job->state = JOB_RUNNING;
+	info->status = wait_job(job);
+	give_terminal(info, getpgrp());
+	if (job->state == JOB_STOPPED)
+	{
+		_putchar('\n');
+		print_job(info, job);
+		return (0);
+	}
+	free_job(job);
+	return (0);
+}
+
+/**
+ * _mybg - resumes a stopped job in the background (man bg)
+ * @info: Structure containing potential arguments. Used to maintain
+ *          constant function prototype.
+ *
+ * The status is 1 if there is no such job, 0 otherwise.
+ * Return: 0 on success, 1 if there is no such job
+ */
+int _mybg(info_t *info)
+{
+	job_t *job = find_job(info, info->argv[1]);
+
+	if (!job)
+	{
+		print_error(info, info->argv[1] ? info->argv[1] : "current");
+		_eputs(": no such job\n");
+		info->status = 1;
+		return (1);
+	}
+	if (job->state == JOB_STOPPED)
+	{
+		kill(-job->pgid, SIGCONT);
+		job->state = JOB_RUNNING;
+	}
+	print_job(info, job);
+	info->status = 0;
+	return (0);
+}
@@ -0,0 +1,90 @@
+#include "shell.h"
+
+static int sigchld_pipe[2] = {-1, -1};
+
+/**
+ * sigchld_handler - wakes the shell up when a child changes state
+ * @sig_num: the signal number received, expected to be SIGCHLD
+ *
+ * Only writes a byte to the self-pipe; the children themselves are
+ * reaped by reap_jobs() from the main loop.
+ */
+static void sigchld_handler(__attribute__((unused))int sig_num)
+{
+	int saved_errno = errno;
+
+	write(sigchld_pipe[1], "c", 1);
+	errno = saved_errno;
+}
+
+/**
+ * init_job_control - sets up the job table and SIGCHLD self-pipe
+ * @info: the shell state structure
+ *
+ * Safe to call before every background launch; only the first call
+ * does any work.
+ * Return: 0 on success, -1 on failure
+ */
+int init_job_control(info_t *info)
+{
+	struct sigaction sa;
+
+	if (!info->jobs)
+	{
+		info->jobs = malloc(sizeof(job_t) * JOBS_MAX);
+		if (!info->jobs)
+			return (-1);
+		_memset((void *)info->jobs, 0, sizeof(job_t) * JOBS_MAX);
+	}
+	if (sigchld_pipe[0] != -1)
+		return (0);
+	if (pipe2(sigchld_pipe, O_CLOEXEC | O_NONBLOCK) == -1)
+		return (-1);
+	_memset((void *)&sa, 0, sizeof(sa));
+	sa.sa_handler = sigchld_handler;
+	sa.sa_flags = SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	return (sigaction(SIGCHLD, &sa, NULL));
+}
+
+/**
+ * drain_sigchld - empties the SIGCHLD self-pipe without blocking
+ *
+ * Return: 1 if a child changed state since the last call, 0 otherwise
+ */
+int drain_sigchld(void)
+{
+	char buf[64];
+	int got = 0;
+
+	if (sigchld_pipe[0] == -1)
+		return (0);
+	while (read(sigchld_pipe[0], buf, sizeof(buf)) > 0)
+		got = 1;
+	return (got);
+}
+
+/**
+ * free_job - releases a job table slot
+ * @job: the job to forget
+ */
+void free_job(job_t *job)
+{
+	free(job->cmd);
+	_memset((void *)job, 0, sizeof(job_t));
+}
+
+/**
+ * free_jobs - releases the job table
+ * @info: the shell state structure
+ */
+void free_jobs(info_t *info)
+{
+	int i;
+
+	if (!info->jobs)
+		return;
+	for (i = 0; i < JOBS_MAX; i++)
+		free_job(&info->jobs[i]);
+	bfree((void **)&info->jobs);
+}
@@ -0,0 +1,99 @@
+#include "shell.h"
+
+/**
+ * print_job - prints one line of the jobs listing
+ * @info: the shell state structure
+ * @job: the job to print
+ *
+ * Uses the bash layout: [id], the current (+) or previous (-) job
+ * marker, the state padded to a column, then the command line.
+ */
+void print_job(info_t *info, job_t *job)
+{
+	char *state = "Running";
+	int i, len;
+
+	if (job->state == JOB_STOPPED)
+		state = "Stopped";
+	else if (job->state == JOB_DONE)
+		state = job->status ? "Exit " : "Done";
+	_putchar('[');
+	_puts(convert_number(job->id, 10, 0));
+	_putchar(']');
+	if (job == find_job(info, NULL))
+		_putchar('+');
+	else
+		_putchar(job == find_job(info, "%-") ? '-' : ' ');
+	_puts("  ");
+	_puts(state);
+	len = _strlen(state);
+	if (job->state == JOB_DONE && job->status)
+	{
+		state = convert_number(job->status, 10, 0);
+		_puts(state);
+		len += _strlen(state);
+	}
+	for (i = len; i < 24; i++)
+		_putchar(' ');
+	_puts(job->cmd);
+	_putchar('\n');
+}
+
+/**
+ * notify_jobs - reports and forgets the jobs that have finished
+ * @info: the shell state structure
+ *
+ * Only an interactive shell announces finished jobs before the next
+ * prompt; a script reaps them too, so no zombies pile up, but keeps
+ * them so that wait and jobs can report them.
+ * Return: the number of jobs reported
+ */
+int notify_jobs(info_t *info)
+{
+	int i, n = 0;
+
+	if (!info->jobs)
+		return (0);
+	reap_jobs(info, 0);
+	if (!interactive(info))
+		return (0);
+	for (i = 0; i < JOBS_MAX; i++)
+		if (info->jobs[i].id && info->jobs[i].state == JOB_DONE)
+		{
+			print_job(info, &info->jobs[i]);
+			free_job(&info->jobs[i]);
+			n++;
+		}
+	return (n);
+}
+
+/**
+ * background_job - records a started background pipeline as a job
+ * @info: the shell state structure
+ * @pgid: the process group of the pipeline
+ * @pids: the stage pids, -1 for stages that never started
+ * @n: the number of stages
+ * @cmd: the command line of the job
+ *
+ * An interactive shell announces the job number and pid like bash.
+ * Return: Always 0, the status of starting a background job
+ */
+int background_job(info_t *info, pid_t pgid, pid_t *pids, int n, char *cmd)
+{
+	int k, started = 0;
+	job_t *job;
+
+	for (k = 0; k < n; k++)
+		started += pids[k] != -1;
+	info->last_bg = pids[n - 1] != -1 ? pids[n - 1] : pgid;
+	job = add_job(info, pgid, pids[n - 1], started, cmd);
+	if (job && interactive(info))
+	{
+		_putchar('[');
+		_puts(convert_number(job->id, 10, 0));
+		_puts("] ");
+		_puts(convert_number(info->last_bg, 10, 0));
+		_putchar('\n');
+	}
+	return (info->status = 0);
+}
@@ -0,0 +1,173 @@
+#include "shell.h"
+
+/**
+ * add_job - records a background job in the job table
+ * @info: the shell state structure
+ * @pgid: the process group of the job
+ * @pid: the last process of the job
+ * @nprocs: the number of processes started for the job
+ * @cmd: the command line of the job
+ *
+ * When the table is full, the jobs are reaped and a finished one that
+ * was never reported gives up its slot.
+ * Return: the new job, or NULL if the table is full
+ */
+job_t *add_job(info_t *info, pid_t pgid, pid_t pid, int nprocs, char *cmd)
+{
+	job_t *job = NULL;
+	int i, id = 0;
+
+	if (init_job_control(info) == -1)
+		return (NULL);
+	for (i = 0; i < JOBS_MAX; i++)
+	{
+		if (info->jobs[i].id > id)
+			id = info->jobs[i].id;
+		if (!job && !info->jobs[i].id)
+			job = &info->jobs[i];
+	}
+	if (!job)
+		reap_jobs(info, 1);
+	for (i = 0; !job && i < JOBS_MAX; i++)
+		if (info->jobs[i].state == JOB_DONE)
+			free_job(job = &info->jobs[i]);
+	if (!job)
+		return (NULL);
+	job->id = id + 1;
+	job->pgid = pgid;
+	job->pid = pid;
+	job->nprocs = nprocs;
+	job->state = nprocs ? JOB_RUNNING : JOB_DONE;
+	job->status = nprocs ? 0 : 127;
+	job->cmd = _strdup(cmd);
+	for (i = _strlen(job->cmd);
+		i > 0 && is_delim(job->cmd[i - 1], " \t"); i--)
+		job->cmd[i - 1] = 0;
+	return (job);
+}
+
+/**
+ * find_job - looks up a job from a job spec or a pid
+ * @info: the shell state structure
+ * @spec: %n, %%, %+, %-, a pid, or NULL for the current job
+ *
+ * Return: the job, or NULL if there is no such job
+ */
+job_t *find_job(info_t *info, char *spec)
+{
+	job_t *cur = NULL, *prev = NULL;
+	int i, n = -1;
+
+	if (!info->jobs)
+		return (NULL);
+	if (spec && spec[0] == '%' && spec[1] >= '0' && spec[1] <= '9')
+		n = _erratoi(spec + 1);
+	else if (spec && spec[0] != '%')
+		n = _erratoi(spec);
+	for (i = 0; i < JOBS_MAX; i++)
+	{
+		if (!info->jobs[i].id)
+			continue;
+		if (spec && spec[0] == '%' && info->jobs[i].id == n)
+			return (&info->jobs[i]);
+		if (spec && spec[0] != '%' && (info->jobs[i].pid == n ||
+			info->jobs[i].pgid == n))
+			return (&info->jobs[i]);
+		if (!cur || info->jobs[i].id > cur->id)
+			prev = cur, cur = &info->jobs[i];
+		else if (!prev || info->jobs[i].id > prev->id)
+			prev = &info->jobs[i];
+	}
+	if (n != -1)
+		return (NULL);
+	if (spec && !_strcmp(spec, "%-"))
+		return (prev);
+	return (cur);
+}
+
+/**
+ * update_job - applies one waitpid() result to a job
+ * @job: the job the process belongs to
+ * @pid: the process that changed state
+ * @status: its wait status
+ */
+void update_job(job_t *job, pid_t pid, int status)
+{
+	if (WIFSTOPPED(status))
+	{
+		job->state = JOB_STOPPED;
+		return;
+	}
+	if (WIFCONTINUED(status))
+	{
+		job->state = JOB_RUNNING;
+		return;
+	}
+	if (pid == job->pid)
+	{
+		if (WIFEXITED(status))
+			job->status = WEXITSTATUS(status);
+		else if (WIFSIGNALED(status))
+			job->status = 128 + WTERMSIG(status);
+	}
+	if (--job->nprocs <= 0)
+		job->state = JOB_DONE;
+}
+
+/**
+ * reap_jobs - collects background children without blocking
+ * @info: the shell state structure
+ * @force: check every job even if no SIGCHLD was seen
+ *
+ * Return: the number of state changes collected
+ */
+int reap_jobs(info_t *info, int force)
+{
+	int i, status, n = 0;
+	pid_t pid = 0;
+	job_t *job;
+
+	if (!drain_sigchld() && !force)
+		return (0);
+	for (i = 0; info->jobs && i < JOBS_MAX; i++)
+	{
+		job = &info->jobs[i];
+		if (!job->id || job->state == JOB_DONE)
+			continue;
+		while (job->state != JOB_DONE && (pid = waitpid(-job->pgid,
+			&status, WNOHANG | WUNTRACED | WCONTINUED)) > 0)
+		{
+			update_job(job, pid, status);
+			n++;
+		}
+		if (pid == -1 && errno == ECHILD)
+			job->state = JOB_DONE;
+	}
+	return (n);
+}
+
+/**
+ * wait_job - blocks until a job finishes or stops
+ * @job: the job to wait for
+ *
+ * Return: the job's exit status
+ */
+int wait_job(job_t *job)
+{
+	int status;
+	pid_t pid;
+
+	while (job->state == JOB_RUNNING)
+	{
+		pid = waitpid(-job->pgid, &status, WUNTRACED);
+		if (pid == -1 && errno == EINTR)
+			continue;
+		if (pid == -1)
+		{
+			job->state = JOB_DONE;
+			break;
+		}
+		update_job(job, pid, status);
+	}
+	return (job->status);
+}
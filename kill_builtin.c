@@ -0,0 +1,69 @@
+#include "shell.h"
+
+/**
+ * sig_from_name - converts a signal name or number to its number
+ * @name: "TERM", "SIGTERM" or "15"
+ *
+ * Return: the signal number, or -1 if it is not known
+ */
+int sig_from_name(char *name)
+{
+	char *names[] = {"HUP", "INT", "QUIT", "KILL", "USR1", "USR2",
+		"PIPE", "ALRM", "TERM", "CHLD", "CONT", "STOP", "TSTP", NULL};
+	int nums[] = {SIGHUP, SIGINT, SIGQUIT, SIGKILL, SIGUSR1, SIGUSR2,
+		SIGPIPE, SIGALRM, SIGTERM, SIGCHLD, SIGCONT, SIGSTOP, SIGTSTP};
+	int i;
+
+	if (*name >= '0' && *name <= '9')
+		return (_erratoi(name));
+	if (starts_with(name, "SIG"))
+		name += 3;
+	for (i = 0; names[i]; i++)
+		if (!_strcmp(name, names[i]))
+			return (nums[i]);
+	return (-1);
+}
+
+/**
+ * _mykill - sends a signal to jobs or processes (man kill)
+ * @info: Structure containing potential arguments. Used to maintain
+ *          constant function prototype.
+ *
+ * Accepts "kill [-SIG | -s SIG] %job|pid..."; the default is SIGTERM.
+ * A job spec signals the job's whole process group. The status is 1 if
+ * any target could not be signalled, 0 otherwise.
+ * Return: 0 on success, 1 if any target could not be signalled
+ */
+int _mykill(info_t *info)
+{
+	int i = 1, sig = SIGTERM, ret = 0;
+	job_t *job;
+	pid_t pid;
+
+	if (info->argv[i] && !_strcmp(info->argv[i], "-s") && info->argv[i + 1])
+		sig = sig_from_name(info->argv[++i]), i++;
+	else if (info->argv[i] && info->argv[i][0] == '-')
+		sig = sig_from_name(info->argv[i++] + 1);
+	if (sig == -1 || !info->argv[i])
+	{
+		print_error(info, "usage: kill [-s sigspec | -sigspec] ");
+		_eputs("pid | jobspec\n");
+		info->status = 1;
+		return (1);
+	}
+	for (; info->argv[i]; i++)
+	{
+		job = info->argv[i][0] == '%' ?
+			find_job(info, info->argv[i]) : NULL;
+		pid = job ? -job->pgid : _erratoi(info->argv[i]);
+		if ((!job && (info->argv[i][0] == '%' || pid <= 0)) ||
+			kill(pid, sig) == -1)
+		{
+			ret = 1;
+			print_error(info, info->argv[i]);
+			_eputs(": no such process or job\n");
+		}
+	}
+	info->status = ret;
+	return (ret);
+}
@@ -0,0 +1,99 @@
+#include "shell.h"
+
+/**
+ * spawn_cmd - launches info->path through posix_spawn
+ * @info: holds all the shell state and command information
+ *
+ * posix_spawn shares the shell's address space with the child until
+ * the exec, so no page tables are copied however large the shell is.
+ * A failed exec is reported through the return value rather than by
+ * the child, so the 126 status is set here instead of by wait_cmd().
+ * Return: pid of the child, or -1 if nothing is left to wait for.
+ */
+pid_t spawn_cmd(info_t *info)
+{
+	pid_t child_pid;
+	int err;
+
+	err = posix_spawn(&child_pid, info->path, NULL, NULL,
+		info->argv, get_environ(info));
+	if (err)
+	{
+		info->status = 1;
+		if (err == EACCES)
+		{
+			info->status = 126;
+			print_error(info, "Permission denied\n");
+		}
+		return (-1);
+	}
+	return (child_pid);
+}
+
+/**
+ * vfork_cmd - launches info->path through vfork and execve
+ * @info: holds all the shell state and command information
+ *
+ * The child borrows the shell's memory until execve, so it must not
+ * touch anything the parent owns: on failure it only calls _exit()
+ * with the same codes the fork path uses.
+ * Return: pid of the child, or -1 if vfork failed.
+ */
+pid_t vfork_cmd(info_t *info)
+{
+	pid_t child_pid;
+	char **envp = get_environ(info);
+
+	child_pid = vfork();
+	if (child_pid == 0)
+	{
+		execve(info->path, info->argv, envp);
+		_exit(errno == EACCES ? 126 : 1);
+	}
+	if (child_pid == -1)
+		perror("Error:");
+	return (child_pid);
+}
+
+/**
+ * wait_cmd - waits for a launched command and records its status
+ * @info: holds all the shell state and command information
+ * @pid: the child to wait for
+ *
+ * The child is reaped with wait4() so its resource usage ends up in
+ * info->stats.
+ */
+void wait_cmd(info_t *info, pid_t pid)
+{
+	struct rusage ru;
+
+	if (pid == -1)
+		return;
+	if (wait4(pid, &(info->status), 0, &ru) == -1)
+	{
+		perror("Error:");
+		return;
+	}
+	finish_cmd(info, &ru);
+}
+
+/**
+ * finish_cmd - records the outcome of a reaped command
+ * @info: holds all the shell state, info->status is the wait status
+ * @ru: the resource usage of the command
+ *
+ * Converts a normal exit into its exit code and reports the
+ * 126 status the child uses for a failed exec.
+ */
+void finish_cmd(info_t *info, struct rusage *ru)
+{
+	stats_add(info, ru);
+	stats_end(info);
+	if (WIFEXITED(info->status))
+	{
+		info->status = WEXITSTATUS(info->status);
+		if (info->status == 126)
+			print_error(info, "Permission denied\n");
+	}
+}
+
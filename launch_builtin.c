@@ -0,0 +1,57 @@
+#include "shell.h"
+
+/**
+ * set_launch_mode - selects the backend fork_cmd() launches with
+ * @info: holds all the shell state and command information
+ * @name: one of "fork", "spawn", "vfork" or "server"
+ *
+ * Return: 0 on success, 1 if the name is unknown.
+ */
+int set_launch_mode(info_t *info, char *name)
+{
+	if (!name)
+		return (1);
+	if (!_strcmp(name, "fork"))
+		info->launch_mode = LAUNCH_FORK;
+	else if (!_strcmp(name, "spawn"))
+		info->launch_mode = LAUNCH_SPAWN;
+	else if (!_strcmp(name, "vfork"))
+		info->launch_mode = LAUNCH_VFORK;
+	else if (!_strcmp(name, "server"))
+		info->launch_mode = LAUNCH_SERVER;
+	else
+		return (1);
+	return (0);
+}
+
+/**
+ * _mylaunch - shows or changes the command launch backend
+ * @info: Structure containing potential arguments. Used to maintain
+ *          constant function prototype.
+ *
+ * With no argument prints the current backend, otherwise switches
+ * to the one named so the backends can be compared in one session.
+ * The status is 1 on an unknown backend, 0 otherwise.
+ * Return: 0 on success, 1 on an unknown backend.
+ */
+int _mylaunch(info_t *info)
+{
+	char *names[] = {"fork", "spawn", "vfork", "server"};
+
+	info->status = 0;
+	if (info->argc == 1)
+	{
+		_puts(names[info->launch_mode]);
+		_putchar('\n');
+		return (0);
+	}
+	if (set_launch_mode(info, info->argv[1]))
+	{
+		print_error(info, "unknown backend: ");
+		_eputs(info->argv[1]);
+		_eputchar('\n');
+		info->status = 1;
+		return (1);
+	}
+	return (0);
+}
@@ -1,13 +1,105 @@
 #include "shell.h"
 
+/**
+ * parallel_opt - takes the "-j N" option off the command line
+ * @info: the shell info structure, info->parallel is set here
+ * @av: the command-line arguments, av[1] being "-j"
+ *
+ * av[2] is replaced by av[0] so the caller can drop the first two
+ * arguments and still have the program name first.
+ */
+static void parallel_opt(info_t *info, char **av)
+{
+	info->parallel = _atoi(av[2]);
+	if (info->parallel < 1 || info->parallel > PARALLEL_MAX)
+	{
+		_eputs(av[0]);
+		_eputs(": 0: Illegal number: ");
+		_eputs(av[2]);
+		_eputchar('\n');
+		_eputchar(BUF_FLUSH);
+		exit(2);
+	}
+	av[2] = av[0];
+}
+
+/**
+ * command_opt - sets up "-c string [arg0 args...]"
+ * @info: the shell info structure
+ * @ac: the count of command-line arguments
+ * @av: the command-line arguments, av[1] being "-c"
+ *
+ * The string is read in place as the shell's input. arg0 and the
+ * arguments after it become $0, $1 and so on, and arg0 is also the
+ * name used in error messages, as in sh.
+ * Return: the argument vector to run the shell with
+ */
+static char **command_opt(info_t *info, int ac, char **av)
+{
+	if (ac < 3)
+	{
+		_eputs(av[0]);
+		_eputs(": 0: -c requires an argument\n");
+		_eputchar(BUF_FLUSH);
+		exit(2);
+	}
+	info->src = av[2];
+	info->src_len = _strlen(av[2]);
+	if (ac == 3)
+		return (av);
+	info->posv = av + 3;
+	info->posc = ac - 3;
+	return (av + 3);
+}
+
+/**
+ * open_script - opens the script file named on the command line
+ * @info: the shell info structure
+ * @av: the command-line arguments, av[1] being the script
+ *
+ * A regular file is mapped rather than read, see map_script().
+ * Exits with the sh status codes if the script cannot be opened.
+ */
+static void open_script(info_t *info, char **av)
+{
+	int fd;
+
+	fd = open(av[1], O_RDONLY);
+	if (fd == -1)
+	{
+		if (errno == EACCES)
+			exit(126);
+		if (errno == ENOENT)
+		{
+			_eputs(av[0]);
+			_eputs(": 0: Can't open ");
+			_eputs(av[1]);
+			_eputchar('\n');
+			_eputchar(BUF_FLUSH);
+			exit(127);
+		}
+		exit(EXIT_FAILURE);
+	}
+	info->readfd = fd;
+	info->posv = av + 1;
+	map_script(info);
+}
+
 /**
  * main - initiates the simple shell program
  * @ac: the count of command-line arguments
  * @av: the array of command-line arguments
  *
  * Initializes the shell's info structure and processes command-line arguments.
- * If a script file is provided, it attempts to open and read from it.
+ * The builtin lookup table is built first; the shell fails if it cannot be.
+ * If a script file is provided, it attempts to open and read from it;
+ * "-j N" before it runs the script's lines on N parallel workers.
+ * "-c string" runs the string instead of reading any input.
+ * A script run as a whole is compiled first, see load_program().
  * Initializes the shell environment, loads history, and starts the shell loop.
+ * HSH_LAUNCH in the environment picks the initial command launch backend;
+ * the fork-server is started before the environment and history are
+ * loaded so that its heap stays small.
  * Return: Exits with appropriate status codes upon
  * encountering file access errors.
  */
@@ -21,28 +113,31 @@ int main(int ac, char **av)
 		: "=r" (fd)
 		: "r" (fd));
 
-	if (ac == 2)
+	if (builtin_init())
+		return (EXIT_FAILURE);
+	info->shell_pid = getpid();
+	if (ac >= 3 && !_strcmp(av[1], "-j"))
 	{
-		fd = open(av[1], O_RDONLY);
-		if (fd == -1)
-		{
-			if (errno == EACCES)
-				exit(126);
-			if (errno == ENOENT)
-			{
-				_eputs(av[0]);
-				_eputs(": 0: Can't open ");
-				_eputs(av[1]);
-				_eputchar('\n');
-				_eputchar(BUF_FLUSH);
-				exit(127);
-			}
-			return (EXIT_FAILURE);
-		}
-		info->readfd = fd;
+		parallel_opt(info, av);
+		av += 2;
+		ac -= 2;
 	}
+	info->posv = av;
+	info->posc = 1;
+	if (ac >= 2 && !_strcmp(av[1], "-c"))
+		av = command_opt(info, ac, av);
+	else if (ac == 2)
+		open_script(info, av);
+	if (getenv("HSH_LAUNCH") && !_strcmp(getenv("HSH_LAUNCH"), "server"))
+		start_fork_server(info);
 	populate_env_list(info);
+	set_launch_mode(info, _getenv(info, "HSH_LAUNCH="));
 	read_history(info);
+	if (info->parallel > 1 && !interactive(info) &&
+		(!info->src || info->src_map))
+		return (run_parallel(info, av));
+	if (info->src_map)
+		load_program(info, av[1]);
 	hsh(info, av);
 	return (EXIT_SUCCESS);
 }
@@ -17,3 +17,29 @@ int bfree(void **ptr)
 	return (0);
 }
 
+/**
+ * grow_line - makes sure a line buffer can hold a number of bytes
+ * @ptr: address of the buffer, which may be NULL
+ * @size: address of the size of the buffer
+ * @need: the number of bytes needed
+ *
+ * The size at least doubles every time, so a long line costs a
+ * handful of reallocations rather than one per block.
+ * Return: 0 on success, -1 if memory ran out
+ */
+int grow_line(char **ptr, size_t *size, size_t need)
+{
+	size_t n = *ptr && *size ? *size : 128;
+	char *p;
+
+	if (*ptr && need <= *size)
+		return (0);
+	while (n < need)
+		n *= 2;
+	p = realloc(*ptr, n);
+	if (!p) /* MALLOC FAILURE! */
+		return (-1);
+	*ptr = p;
+	*size = n;
+	return (0);
+}
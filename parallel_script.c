@@ -0,0 +1,179 @@
+#include "shell.h"
+
+/**
+ * copy_capture - writes out and closes a worker's captured output
+ * @fd: the memfd holding the output
+ * @to: the file descriptor to copy it to
+ */
+static void copy_capture(int fd, int to)
+{
+	char buf[READ_BUF_SIZE * 8];
+	ssize_t n, w, off;
+
+	lseek(fd, 0, SEEK_SET);
+	while ((n = read(fd, buf, sizeof(buf))) > 0)
+		for (off = 0; off < n; off += w)
+		{
+			w = write(to, buf + off, n - off);
+			if (w == -1 && errno == EINTR)
+				w = 0;
+			else if (w <= 0)
+				break;
+		}
+	close(fd);
+}
+
+/**
+ * start_worker - runs one script line in a worker process
+ * @info: the shell state structure
+ * @av: argument vector passed from the main function
+ * @w: the free worker slot, with w->lineno set
+ * @line: the script line
+ *
+ * The worker is the shell itself, reading the line from memory
+ * instead of the script, so a && or || chain on the line runs in order
+ * exactly as it would without -j. Its stdout and stderr go to memfds
+ * the parent copies out once it is the worker's turn.
+ */
+static void start_worker(info_t *info, char **av, worker_t *w, char *line)
+{
+	w->done = 0;
+	w->out = memfd_create("hsh-stdout", MFD_CLOEXEC);
+	w->err = memfd_create("hsh-stderr", MFD_CLOEXEC);
+	w->pid = w->out == -1 || w->err == -1 ? -1 : fork();
+	if (w->pid == 0)
+	{
+		dup2(w->out, STDOUT_FILENO);
+		dup2(w->err, STDERR_FILENO);
+		info->src = line;
+		info->src_len = _strlen(line);
+		info->src_pos = 0;
+		info->src_map = 0;
+		info->line_count = w->lineno - 1;
+		info->parallel = 0;
+		if (info->server_fd)
+		{
+			close(info->server_fd);
+			info->server_fd = 0;
+			info->launch_mode = LAUNCH_SPAWN;
+		}
+		hsh(info, av);
+		exit(EXIT_SUCCESS);
+	}
+	if (w->pid == -1)
+	{
+		perror("Error:");
+		w->status = 1;
+		w->done = 1;
+	}
+}
+
+/**
+ * reap_worker - waits for any worker to finish
+ * @w: the worker slots
+ * @n: the number of slots
+ *
+ * Return: 0 once a worker has been reaped, -1 if there are none left
+ */
+static int reap_worker(worker_t *w, int n)
+{
+	pid_t pid;
+	int status, i;
+
+	while ((pid = wait4(-1, &status, 0, NULL)) != -1 || errno == EINTR)
+		for (i = 0; pid > 0 && i < n; i++)
+			if (w[i].pid == pid && !w[i].done)
+			{
+				w[i].done = 1;
+				w[i].status = WIFEXITED(status) ?
+					WEXITSTATUS(status) :
+					128 + WTERMSIG(status);
+				return (0);
+			}
+	return (-1);
+}
+
+/**
+ * next_line - reads the next non-blank script line
+ * @info: the shell state structure
+ * @lineno: the line number, advanced for every line read
+ *
+ * A line holding nothing but blanks or a comment has no tokens and is
+ * skipped; one that cannot be lexed is left for its worker to report.
+ * Return: the line without its newline, or NULL at end of
+ * input; it is only valid until the next call
+ */
+static char *next_line(info_t *info, unsigned int *lineno)
+{
+	static char *line;
+	static size_t size;
+	int r;
+
+	while ((r = _getline(info, &line, &size)) != -1)
+	{
+		(*lineno)++;
+		if (line[r - 1] == '\n')
+			line[r - 1] = 0;
+		if (lex_line(info, line))
+		{
+			build_history_list(info, line, info->histcount++);
+			return (line);
+		}
+	}
+	if (!info->src)
+		free(line);
+	line = NULL;
+	return (NULL);
+}
+
+/**
+ * run_parallel - runs the lines of a script on info->parallel workers
+ * @info: the shell state structure
+ * @av: argument vector passed from the main function
+ *
+ * Lines are independent: each runs in its own worker, so cd, variables
+ * or exit on one line do not affect the others. At most info->parallel
+ * lines run at a time, and a line's output is only written out once
+ * every line before it has been, so it appears in script order.
+ * Return: the status of the first line that failed, 0 if none did
+ */
+int run_parallel(info_t *info, char **av)
+{
+	worker_t *w;
+	unsigned int head = 0, tail = 0, lineno = 0, n = info->parallel;
+	char *line;
+	int ret = 0, eof = 0;
+
+	w = malloc(sizeof(*w) * n);
+	if (!w)
+		return (hsh(info, av));
+	_putchar(BUF_FLUSH);
+	_eputchar(BUF_FLUSH);
+	while (!eof || head < tail)
+	{
+		line = tail - head < n && !eof ?
+			next_line(info, &lineno) : NULL;
+		if (line)
+		{
+			w[tail % n].lineno = lineno;
+			start_worker(info, av, &w[tail++ % n], line);
+			continue;
+		}
+		eof |= tail - head < n;
+		if (head < tail && !w[head % n].done && reap_worker(w, n) == -1)
+		{
+			w[head % n].status = 1;
+			w[head % n].done = 1;
+		}
+		for (; head < tail && w[head % n].done; head++)
+		{
+			copy_capture(w[head % n].out, STDOUT_FILENO);
+			copy_capture(w[head % n].err, STDERR_FILENO);
+			ret = ret ? ret : w[head % n].status;
+		}
+	}
+	free(w);
+	write_history(info);
+	free_info(info, 1);
+	return (ret);
+}
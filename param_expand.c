@@ -0,0 +1,155 @@
+#include "shell.h"
+
+/**
+ * xbuf_put - appends bytes to the word being expanded
+ * @info: the shell state, whose xbuf holds the word
+ * @s: the bytes
+ * @n: how many
+ *
+ * The buffer is kept from word to word and only ever grows, doubling
+ * from 128 bytes, so expanding a word seldom allocates at all. With
+ * @s NULL room for @n bytes is made but nothing is appended.
+ * Return: 0 on success, -1 if memory ran out
+ */
+int xbuf_put(info_t *info, char *s, size_t n)
+{
+	size_t cap = info->xcap ? info->xcap : 128;
+	char *p;
+
+	if (info->xlen + n > info->xcap)
+	{
+		while (cap < info->xlen + n)
+			cap *= 2;
+		p = realloc(info->xbuf, cap);
+		if (!p)
+			return (-1);
+		info->xbuf = p;
+		info->xcap = cap;
+	}
+	if (s)
+	{
+		memcpy(info->xbuf + info->xlen, s, n);
+		info->xlen += n;
+	}
+	return (0);
+}
+
+/**
+ * xbuf_read - appends everything that can be read from a fd to xbuf
+ * @info: the shell state, whose xbuf receives the bytes
+ * @fd: the fd, read until end of file
+ *
+ * The bytes are read straight into the spare room of xbuf, so the
+ * output of a command substitution is never copied on its way in.
+ * Return: 0 on success, -1 if memory ran out
+ */
+int xbuf_read(info_t *info, int fd)
+{
+	ssize_t n = 1;
+
+	while (n)
+	{
+		if (xbuf_put(info, NULL, READ_BUF_SIZE))
+			return (-1);
+		n = read(fd, info->xbuf + info->xlen, info->xcap - info->xlen);
+		if (n == -1 && errno != EINTR)
+			break;
+		info->xlen += n > 0 ? n : 0;
+	}
+	return (0);
+}
+
+/**
+ * xbuf_split - splits the end of xbuf into fields
+ * @info: the shell state structure
+ * @mark: where the text to split starts in xbuf
+ *
+ * Done in place on the text of an unquoted expansion: every run of
+ * blanks and newlines becomes one null byte ending a field, and one
+ * at the start of the word is dropped. A null byte left at the very
+ * end is taken away by expand_word().
+ */
+void xbuf_split(info_t *info, size_t mark)
+{
+	char *r = info->xbuf + mark, *w = r;
+	char *end = info->xbuf + info->xlen;
+
+	for (; r < end; r++)
+		if (*r && *r != ' ' && *r != '\t' && *r != '\n')
+			*w++ = *r;
+		else if (w > info->xbuf && w[-1])
+			*w++ = 0;
+	info->xlen = w - info->xbuf;
+}
+
+/**
+ * expand_text - expands and unquotes a stretch of a word into xbuf
+ * @info: the shell state structure
+ * @s: the start of the text, as it stands in the command line
+ * @end: the end of the text
+ * @dq: on if the text starts inside double quotes
+ *
+ * Makes a single pass: plain runs are copied as they are, quotes and
+ * backslashes are removed the way unquote() removes them, and every $
+ * and backquote is handed to expand_param() or cmd_subst(), which
+ * write the value straight into xbuf. Nothing is expanded inside
+ * single quotes.
+ * Return: 0 on success, -1 on an arithmetic error or if memory ran out
+ */
+int expand_text(info_t *info, char *s, char *end, int dq)
+{
+	char *p;
+
+	while (s && s < end)
+	{
+		p = s + 1;
+		if (*s == '\'' && !dq)
+		{
+			while (p < end && *p != '\'')
+				p++;
+			s = xbuf_put(info, s + 1, p - s - 1) ? NULL : p + 1;
+		}
+		else if (*s == '"')
+		{
+			dq = !dq;
+			s = p;
+		}
+		else if (*s == '\\' && p < end &&
+			(!dq || _strchr("\\$`\"\n", *p)))
+			s = *p != '\n' && xbuf_put(info, p, 1) ? NULL : p + 1;
+		else if (*s == '$')
+			s = expand_param(info, p, dq);
+		else if (*s == '`')
+			s = cmd_subst(info, s, dq);
+		else
+		{
+			while (p < end && !_strchr("'\"\\$`", *p))
+				p++;
+			s = xbuf_put(info, s, p - s) ? NULL : p;
+		}
+	}
+	return (s ? 0 : -1);
+}
+
+/**
+ * expand_word - expands the parameters in a word and unquotes it
+ * @info: the shell state structure
+ * @s: the word as it stands in the command line
+ *
+ * Unquoted expansions may have split the word into fields, which are
+ * then separated by null bytes in xbuf; xlen tells where they end.
+ * Return: the expanded word in info->xbuf, which the next word
+ * overwrites, or NULL on an arithmetic error or if memory ran out
+ */
+char *expand_word(info_t *info, char *s)
+{
+	info->xlen = 0;
+	if (expand_text(info, s, s + _strlen(s), 0))
+		return (NULL);
+	if (info->xlen && !info->xbuf[info->xlen - 1])
+		info->xlen--;
+	if (xbuf_put(info, "", 1))
+		return (NULL);
+	info->xlen--;
+	return (info->xbuf);
+}
@@ -0,0 +1,135 @@
+#include "shell.h"
+
+/**
+ * name_len - measures the parameter name at the start of a string
+ * @s: the text right after the $ or ${
+ * @braced: on inside ${...}, where a positional parameter can have
+ * more than one digit
+ *
+ * Return: the length of the name, 0 if there is none
+ */
+static size_t name_len(char *s, int braced)
+{
+	char *p = s;
+
+	if (_isalpha(*p) || *p == '_')
+		while (_isalpha(*p) || *p == '_' || (*p >= '0' && *p <= '9'))
+			p++;
+	else if (*p >= '0' && *p <= '9')
+		while (*++p >= '0' && *p <= '9' && braced)
+			;
+	else if (*p && _strchr("?$!#@*", *p))
+		p++;
+	return (p - s);
+}
+
+/**
+ * put_param - appends the value of a parameter to xbuf
+ * @info: the shell state structure
+ * @name: the name, which need not be null-terminated
+ * @n: the length of the name
+ * @len_of: on to append the length of the value instead
+ * @dq: on if the parameter is inside double quotes; if not, the value
+ * is split into fields
+ *
+ * $@ and $* are the positional parameters joined by spaces.
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int put_param(info_t *info, char *name, size_t n, int len_of, int dq)
+{
+	char *val = param_value(info, name, n), **posv = info->posv;
+	size_t mark = info->xlen;
+	int k;
+
+	if (len_of)
+		val = convert_number(val ? _strlen(val) : 0, 10, 0);
+	else if (n == 1 && (*name == '@' || *name == '*'))
+		for (k = 1; k < info->posc; k++)
+			if ((k > 1 && xbuf_put(info, " ", 1)) ||
+				xbuf_put(info, posv[k], _strlen(posv[k])))
+				return (-1);
+	if (val && xbuf_put(info, val, _strlen(val)))
+		return (-1);
+	if (!dq)
+		xbuf_split(info, mark);
+	return (0);
+}
+
+/**
+ * assign_default - sets a variable to the default ${X:=def} expanded
+ * @info: the shell state structure
+ * @name: the variable name, in the word being expanded
+ * @n: the length of the name
+ * @mark: where the expanded default starts in xbuf
+ *
+ * The name is ended in place for the time of the call, so nothing is
+ * copied; only variables can be assigned, not special or positional
+ * parameters. A variable this sets is not exported.
+ * Return: 0 on success, -1 if the variable is read-only or memory ran
+ * out
+ */
+static int assign_default(info_t *info, char *name, size_t n, size_t mark)
+{
+	char c = name[n];
+	int k;
+
+	if (!_isalpha(*name) && *name != '_')
+		return (0);
+	if (xbuf_put(info, "", 1))
+		return (-1);
+	info->xlen--;
+	name[n] = 0;
+	k = var_set(info, name, info->xbuf + mark, 0);
+	name[n] = c;
+	return (k);
+}
+
+/**
+ * expand_param - expands one $ parameter into xbuf
+ * @info: the shell state structure
+ * @s: the text right after the $
+ * @dq: on if the $ is inside double quotes
+ *
+ * Handles $NAME, $0 to $9, $?, $$, $!, $#, $@, $*, ${NAME}, ${#NAME},
+ * ${NAME:-def} and ${NAME:=def}; $((...)) goes to arith_subst() and
+ * $(...) to cmd_subst(). The default is only expanded when it is used.
+ * A $ that starts no expansion is kept as it is.
+ * Return: the text after the expansion, NULL on an arithmetic error,
+ * an assignment to a read-only variable or if memory ran out
+ */
+char *expand_param(info_t *info, char *s, int dq)
+{
+	char *end, *val;
+	size_t n, mark;
+	int len_of;
+
+	if (*s == '(' && s[1] == '(')
+		return (arith_subst(info, s, dq));
+	if (*s == '(')
+		return (cmd_subst(info, s, dq));
+	if (*s != '{')
+	{
+		n = name_len(s, 0);
+		if (!n)
+			return (xbuf_put(info, "$", 1) ? NULL : s);
+		return (put_param(info, s, n, 0, dq) ? NULL : s + n);
+	}
+	end = brace_end(s + 1);
+	len_of = s[1] == '#' && s[2] != '}';
+	n = name_len(s + 1 + len_of, 1);
+	val = s + 1 + len_of;
+	if (!end || !n || (val + n != end && (len_of || val[n] != ':' ||
+		(val[n + 1] != '-' && val[n + 1] != '='))))
+		return (xbuf_put(info, "$", 1) ? NULL : s);
+	if (val + n == end)
+		return (put_param(info, val, n, len_of, dq) ? NULL : end + 1);
+	s = val;
+	val = param_value(info, s, n);
+	if (val && *val)
+		return (put_param(info, s, n, 0, dq) ? NULL : end + 1);
+	mark = info->xlen;
+	if (expand_text(info, s + n + 2, end, dq) ||
+		(s[n + 1] == '=' && assign_default(info, s, n, mark)))
+		return (NULL);
+	return (end + 1);
+}
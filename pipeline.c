@@ -0,0 +1,222 @@
+#include "shell.h"
+
+/**
+ * split_pipeline - finds the stages of a pipeline
+ * @info: the shell state, info->nodes holding the line's tree
+ * @i: the pipeline's node
+ * @n: set to the number of stages
+ *
+ * The stages of cmd1 | cmd2 | cmd3 nest to the left, so they are the
+ * right operands down the left spine, and the node that ends it.
+ * Anything but an N_PIPE node is a pipeline of one stage.
+ * Return: a malloc'd array of the n stage nodes, NULL on allocation
+ * failure
+ */
+int *split_pipeline(info_t *info, int i, int *n)
+{
+	node_t *nd = info->nodes;
+	int *stages, k = 1, j;
+
+	for (j = i; nd[j].type == N_PIPE; j = nd[j].a)
+		k++;
+	stages = malloc(sizeof(int) * k);
+	if (!stages)
+		return (NULL);
+	*n = k;
+	for (j = i; nd[j].type == N_PIPE; j = nd[j].a)
+		stages[--k] = nd[j].b;
+	stages[0] = j;
+	return (stages);
+}
+
+/**
+ * exec_stage - runs one pipeline stage inside its child process
+ * @info: holds all the shell state and command information
+ * @av: argument vector from main
+ * @node: the stage's node
+ * @builtin: the builtin to run in-process, or NULL
+ *
+ * Builtins, groups and subshells run in the child like a subshell
+ * would, so they cannot change the state of the shell itself; a simple
+ * command that is not a builtin is exec'd. The redirections of a simple
+ * command or subshell are set up here, with nothing to undo; a group
+ * sees to its own. Never returns.
+ */
+static void exec_stage(info_t *info, char **av, int node,
+	builtin_table *builtin)
+{
+	node_t *nd = info->nodes + node;
+	int ret;
+
+	if ((nd->type == N_CMD || nd->type == N_SUBSHELL) && redirect(info,
+		info->toks + nd->b, nd->tok + nd->ntok - nd->b, NULL))
+		_exit(1);
+	if (builtin || nd->type != N_CMD || !info->argc)
+	{
+		if (builtin)
+			ret = builtin->func(info);
+		else if (nd->type == N_CMD)
+			ret = info->status = 0;
+		else
+			ret = run_node(info, av,
+				nd->type == N_SUBSHELL ? nd->a : node, 0);
+		if (ret == -2 && info->err_num != -1)
+			ret = info->err_num;
+		else if (ret == -2 || !builtin)
+			ret = info->status;
+		_putchar(BUF_FLUSH);
+		_eputchar(BUF_FLUSH);
+		_exit(ret);
+	}
+	execve(info->path, info->argv, get_environ(info));
+	ret = errno == EACCES ? 126 : 1;
+	if (ret == 126)
+		print_error(info, "Permission denied\n");
+	_eputchar(BUF_FLUSH);
+	_exit(ret);
+}
+
+/**
+ * start_stage - starts one pipeline stage without waiting for it
+ * @info: holds all the shell state, info->nodes the line's tree
+ * @av: argument vector from main
+ * @node: the stage's node
+ * @in_fd: the fd the stage reads from
+ * @fds: the pipe the stage writes to, fds[1] the fd it writes to and
+ * fds[0] the read end, closed in the child so a stage that is not
+ * exec'd still gets SIGPIPE when its reader exits; STDIN_FILENO and
+ * STDOUT_FILENO for the last stage
+ * @pgid: the job's process group for a background stage, 0 to make
+ * this stage the group leader; NULL for a foreground stage
+ *
+ * A simple command is expanded and resolved in the shell so the
+ * location cache is kept up to date; one that cannot be expanded or
+ * found is reported and skipped.
+ * Return: the pid of the stage, or -1 if it was not started
+ */
+pid_t start_stage(info_t *info, char **av, int node, int in_fd, int *fds,
+	pid_t *pgid)
+{
+	node_t *nd = info->nodes + node;
+	builtin_table *builtin = NULL;
+	pid_t child_pid;
+
+	info->argc = 0;
+	if (nd->type == N_CMD && nd->ntok)
+	{
+		info->cmd_toks = info->toks + nd->tok;
+		info->cmd_ntok = nd->ntok;
+		info->arg = node_text(info, nd);
+		if (set_info(info, av))
+			return (-1);
+		builtin = info->argc ? get_builtin(info->argv[0]) : NULL;
+		info->path = builtin || !info->argc ? NULL : locate_cmd(info);
+		if (!builtin && !info->path && info->argc)
+			return (print_error(info, "not found\n"), -1);
+	}
+	if (pgid && init_job_control(info) == -1)
+		return (-1);
+	_putchar(BUF_FLUSH);
+	_eputchar(BUF_FLUSH);
+	child_pid = fork();
+	if (child_pid == -1)
+		perror("Error:");
+	if (child_pid > 0 && pgid)
+		setpgid(child_pid, *pgid ? *pgid : (*pgid = child_pid));
+	if (child_pid == 0)
+	{
+		if (pgid)
+			setpgid(0, *pgid);
+		if (pgid && in_fd == STDIN_FILENO && !interactive(info))
+			in_fd = open("/dev/null", O_RDONLY);
+		if (in_fd != STDIN_FILENO)
+			dup2(in_fd, STDIN_FILENO), close(in_fd);
+		if (fds[1] != STDOUT_FILENO)
+			dup2(fds[1], STDOUT_FILENO), close(fds[1]),
+				close(fds[0]);
+		exec_stage(info, av, node, builtin);
+	}
+	return (child_pid);
+}
+
+/**
+ * wait_pipeline - reaps every stage of a pipeline
+ * @info: holds all the shell state and command information
+ * @pids: the stage pids, -1 for stages that never started
+ * @n: the number of stages
+ *
+ * The status is that of the last stage, or with pipefail on that of
+ * the rightmost stage that failed. The resource usage of all stages
+ * is added up in info->stats.
+ * Return: the pipeline status
+ */
+int wait_pipeline(info_t *info, pid_t *pids, int n)
+{
+	int k, status, ret = 0;
+	struct rusage ru;
+
+	for (k = 0; k < n; k++)
+	{
+		status = 127;
+		if (pids[k] != -1 && wait4(pids[k], &status, 0, &ru) != -1)
+		{
+			stats_add(info, &ru);
+			if (WIFEXITED(status))
+				status = WEXITSTATUS(status);
+			else if (WIFSIGNALED(status))
+				status = 128 + WTERMSIG(status);
+		}
+		if (info->pipefail ? status != 0 : k == n - 1)
+			ret = status;
+	}
+	stats_end(info);
+	return (info->status = ret);
+}
+
+/**
+ * run_pipeline - runs a pipeline, a subshell or a background job
+ * @info: holds all the shell state, info->nodes the line's tree
+ * @av: argument vector from main
+ * @i: the N_PIPE, N_SUBSHELL or N_BG node
+ *
+ * Every stage is a child process and all of them run concurrently. A
+ * job run with & is put in its own process group and recorded in the
+ * job table instead of being waited for.
+ * Return: the pipeline status
+ */
+int run_pipeline(info_t *info, char **av, int i)
+{
+	int bg = info->nodes[i].type == N_BG, *stages, n, k, in_fd = 0, fds[2];
+	char *cmd = NULL;
+	pid_t *pids, pgid = 0;
+
+	i = bg ? info->nodes[i].a : i;
+	cmd = bg ? _strdup(node_text(info, info->nodes + i)) : NULL;
+	info->line_count += info->linecount_flag == 1;
+	info->linecount_flag = 0;
+	stages = split_pipeline(info, i, &n);
+	pids = stages ? malloc(sizeof(pid_t) * n) : NULL;
+	if (!pids)
+		return (free(stages), free(cmd), info->status);
+	stats_begin(info);
+	for (k = 0; k < n; k++)
+	{
+		fds[0] = STDIN_FILENO, fds[1] = STDOUT_FILENO;
+		if (k < n - 1 && pipe2(fds, O_CLOEXEC) == -1)
+			perror("Error:");
+		pids[k] = start_stage(info, av, stages[k], in_fd, fds,
+			bg ? &pgid : NULL);
+		arena_reset(info);
+		info->argv = NULL;
+		if (in_fd != STDIN_FILENO)
+			close(in_fd);
+		if (fds[1] != STDOUT_FILENO)
+			close(fds[1]);
+		in_fd = fds[0];
+	}
+	if (bg)
+		background_job(info, pgid, pids, n, cmd);
+	else
+		wait_pipeline(info, pids, n);
+	return (free(stages), free(pids), free(cmd), info->status);
+}
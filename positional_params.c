@@ -0,0 +1,86 @@
+#include "shell.h"
+
+/**
+ * splice_params - replaces argv[i] with the positional parameters
+ * @info: the shell state structure
+ * @i: the index of the "$@" or "$*" word
+ *
+ * The parameters become separate words, as they do unquoted in sh.
+ * An empty word is left behind only if argv would otherwise be empty.
+ * Return: the index of the last word inserted, i - 1 if there were none
+ */
+static int splice_params(info_t *info, int i)
+{
+	int n, k = info->posc > 1 ? info->posc - 1 : 0, j;
+	char **argv;
+
+	for (n = 0; info->argv[n]; n++)
+		;
+	if (!k && n == 1)
+		return (replace_arg(info, i, ""), i);
+	argv = arena_alloc(info, sizeof(char *) * (n + k));
+	if (!argv)
+		return (i);
+	for (j = 0; j < i; j++)
+		argv[j] = info->argv[j];
+	for (j = 0; j < k; j++)
+		argv[i + j] = arena_dup(info, info->posv[j + 1]);
+	for (j = i + 1; j <= n; j++)
+		argv[j - 1 + k] = info->argv[j];
+	info->argv = argv;
+	info->argc = n - 1 + k;
+	return (i + k - 1);
+}
+
+/**
+ * replace_param - splices the positional parameters into argv
+ * @info: the shell state structure
+ * @i: the index of the word, moved to the last word it expanded to
+ *
+ * Only a word that is just $@, $* or "$@" becomes several words; the
+ * parameters anywhere else are joined by expand_param().
+ * Return: 1 if argv[*i] was spliced, 0 otherwise
+ */
+int replace_param(info_t *info, int *i)
+{
+	char *w = info->argv[*i];
+
+	if (_strcmp(w, "$@") && _strcmp(w, "$*") && _strcmp(w, "\"$@\""))
+		return (0);
+	*i = splice_params(info, *i);
+	return (1);
+}
+
+/**
+ * param_value - looks up the value of a parameter
+ * @info: the shell state structure
+ * @name: the name, which need not be null-terminated
+ * @n: the length of the name
+ *
+ * Special parameters come from the shell state, $$ being the pid of the
+ * shell even in a subshell, $0 on from posv and
+ * anything else from the environment. $@ and $* have no single value.
+ * Return: the value, which may be in a static buffer, NULL if unset
+ */
+char *param_value(info_t *info, char *name, size_t n)
+{
+	envvar_t *v;
+	size_t k = 0, j;
+
+	if (n == 1 && *name == '?')
+		return (convert_number(info->status, 10, 0));
+	if (n == 1 && *name == '$')
+		return (convert_number(info->shell_pid, 10, 0));
+	if (n == 1 && *name == '#')
+		return (convert_number(info->posc - (info->posc > 0), 10, 0));
+	if (n == 1 && *name == '!' && info->last_bg)
+		return (convert_number(info->last_bg, 10, 0));
+	if (*name >= '0' && *name <= '9')
+	{
+		for (j = 0; j < n && k < (size_t)info->posc; j++)
+			k = k * 10 + name[j] - '0';
+		return (k < (size_t)info->posc ? info->posv[k] : NULL);
+	}
+	v = env_find(info, name, n);
+	return (v ? v->str + n + 1 : NULL);
+}
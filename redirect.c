@@ -0,0 +1,196 @@
+#include "shell.h"
+
+/*
+ * Per redirection operator, from TOK_LESS to TOK_LESSGREAT: the flags
+ * its file is opened with and the fd it applies to when none is given.
+ */
+static const int redir_flags[] = {
+	O_RDONLY, O_WRONLY | O_CREAT | O_TRUNC, O_WRONLY | O_CREAT | O_APPEND,
+	0, 0, O_RDWR | O_CREAT
+};
+static const int redir_fd[] = {0, 1, 1, 0, 1, 0};
+
+/**
+ * redir_target - gives the expanded word a redirection applies to
+ * @info: the shell state, info->line holding the word
+ * @t: the word's token
+ *
+ * The word is expanded like an argument but never split: fields are
+ * joined back with spaces, the way sh treats a redirection target.
+ * Return: the word, in the arena or in xbuf, NULL if memory ran out
+ */
+static char *redir_target(info_t *info, token_t *t)
+{
+	char **w = tokenize(info, t, 1);
+	size_t i;
+
+	if (!w || !(t->flags & TF_DOLLAR))
+		return (w ? *w : NULL);
+	if (!expand_word(info, *w))
+		return (NULL);
+	for (i = 0; i < info->xlen; i++)
+		if (!info->xbuf[i])
+			info->xbuf[i] = ' ';
+	return (info->xbuf);
+}
+
+/**
+ * redir_open - opens what a redirection points the fd at
+ * @t: the redirection's token
+ * @word: its expanded word
+ *
+ * For >& and <& the word is a fd, which is only checked, or - to close
+ * the fd; every other operator opens the word as a file, close-on-exec
+ * so that it never leaks into a command on its own.
+ * Return: the fd to put in place, -2 to close it, -1 on error
+ */
+static int redir_open(token_t *t, char *word)
+{
+	char *p = word;
+
+	if (t->type != TOK_GREATAND && t->type != TOK_LESSAND)
+		return (open(word, redir_flags[t->type - TOK_LESS] | O_CLOEXEC,
+			0666));
+	if (!_strcmp(word, "-"))
+		return (-2);
+	while (*p >= '0' && *p <= '9')
+		p++;
+	errno = EBADF;
+	if (p == word || *p || p - word > 4 ||
+		fcntl(_atoi(word), F_GETFD) == -1)
+		return (-1);
+	return (_atoi(word));
+}
+
+/**
+ * redir_one - applies one redirection
+ * @info: the shell state structure
+ * @t: the redirection's token, followed by its word
+ * @save: the list of saved fds to add to, NULL not to save any
+ *
+ * Before anything is opened a close-on-exec copy of the fd is saved,
+ * so undo_redirect() can put it back; -1 stands for a fd that was
+ * closed. A fd above 2 is counted in info->redir_high until then.
+ * dup2() clears close-on-exec on the fd it fills, so dup3() is never
+ * needed, but a file opened straight onto a closed fd still has it.
+ * Return: 0 on success, 1 if the redirection failed, after saying why
+ */
+static int redir_one(info_t *info, token_t *t, int *save)
+{
+	int fd = t->fd != -1 ? t->fd : redir_fd[t->type - TOK_LESS], from;
+	int is_dup = t->type == TOK_GREATAND || t->type == TOK_LESSAND;
+	char *word = redir_target(info, t + 1);
+
+	if (!word)
+		return (_eputs("hsh: out of memory\n"), 1);
+	info->redir_high += fd > 2;
+	if (save)
+	{
+		while (*save != -1)
+			save += 2;
+		save[0] = fd;
+		save[1] = fcntl(fd, F_DUPFD_CLOEXEC, 10);
+		save[2] = -1;
+	}
+	from = redir_open(t, word);
+	if (from == -2)
+		close(fd);
+	else if (from == fd && !is_dup)
+		fcntl(fd, F_SETFD, 0);
+	else if (from != -1 && from != fd && dup2(from, fd) == -1)
+		from = -1;
+	if (from >= 0 && from != fd && !is_dup)
+		close(from);
+	if (from != -1)
+		return (0);
+	info->line_count += info->linecount_flag == 1;
+	info->linecount_flag = 0;
+	_eputs(info->fname);
+	_eputs(": ");
+	print_d(info->line_count, STDERR_FILENO);
+	_eputs(": cannot open ");
+	_eputs(word);
+	_eputs(": ");
+	_eputs(strerror(errno));
+	_eputchar('\n');
+	return (1);
+}
+
+/**
+ * redirect - applies the redirections among a command's tokens
+ * @info: the shell state structure
+ * @t: the tokens; each redirection is followed by its word, and words
+ * that are not redirected are skipped
+ * @n: the number of tokens
+ * @saved: NULL in a child that is about to exec, where nothing needs
+ * to be put back; otherwise set to the fds undo_redirect() restores,
+ * or to NULL if there were no redirections
+ *
+ * Redirections apply from left to right, so 2>&1 >f leaves stderr on
+ * the old stdout. The shell's output buffers are flushed first so that
+ * nothing already printed follows a fd somewhere else. When one fails,
+ * those applied before it are undone.
+ * Return: 0 on success, 1 if a redirection failed, after saying why
+ */
+int redirect(info_t *info, token_t *t, int n, int **saved)
+{
+	int i, k = 0, err = 0;
+
+	for (i = 0; i < n; i++)
+		k += IS_REDIR(t[i].type);
+	if (saved)
+		*saved = NULL;
+	if (!k)
+		return (0);
+	_putchar(BUF_FLUSH);
+	_eputchar(BUF_FLUSH);
+	if (saved)
+	{
+		*saved = malloc(sizeof(int) * (2 * k + 1));
+		if (!*saved)
+			return (_eputs("hsh: out of memory\n"), 1);
+		**saved = -1;
+	}
+	for (i = 0; !err && i + 1 < n; i++)
+		if (IS_REDIR(t[i].type))
+			err = redir_one(info, t + i++, saved ? *saved : NULL);
+	_eputchar(BUF_FLUSH);
+	if (err && saved)
+	{
+		undo_redirect(info, *saved);
+		*saved = NULL;
+	}
+	return (err);
+}
+
+/**
+ * undo_redirect - puts back the fds redirect() saved
+ * @info: the shell state structure
+ * @saved: the saved fds, or NULL if there are none
+ *
+ * The fds are restored in the opposite order to the redirections, so
+ * a fd redirected twice ends up as it first was; the list is freed.
+ */
+void undo_redirect(info_t *info, int *saved)
+{
+	int k = 0;
+
+	if (!saved)
+		return;
+	_putchar(BUF_FLUSH);
+	_eputchar(BUF_FLUSH);
+	while (saved[k] != -1)
+		k += 2;
+	while ((k -= 2) >= 0)
+	{
+		info->redir_high -= saved[k] > 2;
+		if (saved[k + 1] == -1)
+			close(saved[k]);
+		else
+		{
+			dup2(saved[k + 1], saved[k]);
+			close(saved[k + 1]);
+		}
+	}
+	free(saved);
+}
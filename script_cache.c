@@ -0,0 +1,187 @@
+#include "shell.h"
+
+/**
+ * cache_name - builds the name of a script's cache file
+ * @path: the script path
+ *
+ * Return: the malloc'd path with PROG_CACHE_EXT appended, or NULL
+ */
+static char *cache_name(char *path)
+{
+	char *name = malloc(_strlen(path) + _strlen(PROG_CACHE_EXT) + 1);
+
+	if (!name)
+		return (NULL);
+	_strcpy(name, path);
+	return (_strcat(name, PROG_CACHE_EXT));
+}
+
+/**
+ * check_line - validates the tokens and nodes of one cached line
+ * @h: the mapped cache file, whose sizes are already checked
+ * @l: the line record
+ *
+ * Every token must end before the null byte that ends the pool, and
+ * every node must only span the line's tokens and only point to nodes
+ * of the line that come before it, or for redirections to its own
+ * tokens, so running the tree cannot leave the mapping or loop.
+ * Return: 1 if the line is sound, 0 otherwise
+ */
+static int check_line(proghdr_t *h, linerec_t *l)
+{
+	token_t *t = (token_t *)((linerec_t *)(h + 1) + h->nlines);
+	node_t *nd = (node_t *)(t + h->ntoks);
+	unsigned int k, room = h->pool_len - l->text;
+	int bad;
+
+	if (l->text >= h->pool_len || l->tok > h->ntoks ||
+		l->ntok > h->ntoks - l->tok || l->node > h->nnodes ||
+		l->nnode > h->nnodes - l->node)
+		return (0);
+	for (k = l->tok; k < l->tok + l->ntok; k++)
+		if (t[k].start >= room || t[k].len >= room - t[k].start
+			|| t[k].type >= TOK_MAX)
+			return (0);
+	for (nd += l->node, k = 0; k < l->nnode; k++, nd++)
+	{
+		bad = nd->type > N_SUBSHELL || nd->tok > l->ntok ||
+			nd->ntok > l->ntok - nd->tok;
+		if (nd->type != N_CMD)
+			bad |= nd->a < 0 || (unsigned int)nd->a >= k;
+		if (nd->type != N_CMD && nd->type < N_BG)
+			bad |= nd->b < 0 || (unsigned int)nd->b >= k;
+		else if (nd->type != N_BG)
+			bad |= nd->b < 0 || (unsigned int)nd->b < nd->tok ||
+				(unsigned int)nd->b > nd->tok + nd->ntok;
+		if (bad)
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * check_cache - validates a mapped cache file against its script
+ * @h: the mapped cache file
+ * @len: the length of the mapping
+ * @st: the script's status
+ *
+ * A cache is only used for the exact script it was made from, and
+ * every record must hold up to check_line(), so a stale or damaged
+ * cache is ignored rather than run.
+ * Return: 1 if the cache can be used, 0 otherwise
+ */
+static int check_cache(proghdr_t *h, size_t len, struct stat *st)
+{
+	linerec_t *l = (linerec_t *)(h + 1);
+	token_t *t = (token_t *)(l + h->nlines);
+	node_t *nd = (node_t *)(t + h->ntoks);
+	char *pool = (char *)(nd + h->nnodes);
+	unsigned int i;
+
+	if (len < sizeof(*h) || memcmp(h->magic, PROG_MAGIC, 4) ||
+		h->size != (long)st->st_size ||
+		h->mtime != (long)st->st_mtim.tv_sec ||
+		h->mtime_ns != (long)st->st_mtim.tv_nsec || !h->nlines ||
+		h->nlines > len / sizeof(*l) || h->ntoks > len / sizeof(*t) ||
+		h->nnodes > len / sizeof(*nd) || !h->pool_len ||
+		len != sizeof(*h) + sizeof(*l) * h->nlines +
+		sizeof(*t) * h->ntoks + sizeof(*nd) * h->nnodes + h->pool_len ||
+		pool[h->pool_len - 1])
+		return (0);
+	for (i = 0; i < h->nlines; i++)
+		if (!check_line(h, l + i))
+			return (0);
+	return (1);
+}
+
+/**
+ * load_cache - loads the cached compiled form of a script
+ * @path: the script path
+ * @st: the script's status
+ *
+ * The cache file is mapped private and writable, like a script, so
+ * commands can be terminated in place as they run.
+ * Return: the program, or NULL if there is no usable cache
+ */
+prog_t *load_cache(char *path, struct stat *st)
+{
+	char *name = cache_name(path);
+	struct stat cst;
+	proghdr_t *h = MAP_FAILED;
+	prog_t *pg = NULL;
+	int fd = name ? open(name, O_RDONLY | O_CLOEXEC) : -1;
+
+	free(name);
+	if (fd != -1 && !fstat(fd, &cst) && cst.st_size > 0)
+		h = mmap(NULL, cst.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+			fd, 0);
+	if (fd != -1)
+		close(fd);
+	if (h == MAP_FAILED)
+		return (NULL);
+	if (check_cache(h, cst.st_size, st))
+		pg = malloc(sizeof(*pg));
+	if (!pg)
+	{
+		munmap(h, cst.st_size);
+		return (NULL);
+	}
+	_memset((char *)pg, 0, sizeof(*pg));
+	pg->blob = (char *)h;
+	pg->blob_len = cst.st_size;
+	pg->nlines = h->nlines;
+	pg->lines = (linerec_t *)(h + 1);
+	pg->ntoks = h->ntoks;
+	pg->toks = (token_t *)(pg->lines + pg->nlines);
+	pg->nnodes = h->nnodes;
+	pg->nodes = (node_t *)(pg->toks + pg->ntoks);
+	pg->pool = (char *)(pg->nodes + pg->nnodes);
+	pg->pool_len = h->pool_len;
+	return (pg);
+}
+
+/**
+ * save_cache - saves a compiled script next to the script
+ * @pg: the compiled program
+ * @path: the script path
+ * @st: the script's status when it was compiled
+ *
+ * The file is written under a temporary name and renamed into place,
+ * so a shell running the same script never sees half a cache. Any
+ * failure just leaves the script uncached.
+ */
+void save_cache(prog_t *pg, char *path, struct stat *st)
+{
+	char *name = cache_name(path), *tmp;
+	proghdr_t h;
+	int fd = -1;
+
+	tmp = name ? malloc(_strlen(name) + 8) : NULL;
+	if (tmp)
+		fd = mkstemp(_strcat(_strcpy(tmp, name), ".XXXXXX"));
+	_memset((char *)&h, 0, sizeof(h));
+	memcpy(h.magic, PROG_MAGIC, 4);
+	h.nlines = pg->nlines;
+	h.ntoks = pg->ntoks;
+	h.nnodes = pg->nnodes;
+	h.size = st->st_size;
+	h.mtime = st->st_mtim.tv_sec;
+	h.mtime_ns = st->st_mtim.tv_nsec;
+	h.pool_len = pg->pool_len;
+	if (fd != -1)
+	{
+		if (write_all(fd, &h, sizeof(h)) ||
+			write_all(fd, pg->lines,
+				sizeof(*pg->lines) * pg->nlines) ||
+			write_all(fd, pg->toks,
+				sizeof(*pg->toks) * pg->ntoks) ||
+			write_all(fd, pg->nodes,
+				sizeof(*pg->nodes) * pg->nnodes) ||
+			write_all(fd, pg->pool, pg->pool_len) ||
+			fchmod(fd, 0644) || rename(tmp, name))
+			unlink(tmp);
+		close(fd);
+	}
+	free(tmp);
+	free(name);
+}
@@ -0,0 +1,120 @@
+#include "shell.h"
+
+/**
+ * grow_array - makes sure an array being compiled has room to spare
+ * @arr: address of the array, which may be NULL
+ * @cap: address of the number of elements it has room for
+ * @need: the number of elements needed
+ * @size: the size of an element
+ *
+ * Return: 0 on success, -1 if memory ran out
+ */
+static int grow_array(void **arr, size_t *cap, size_t need, size_t size)
+{
+	size_t n = *cap ? *cap : 256;
+	void *p;
+
+	while (n < need)
+		n *= 2;
+	if (n == *cap)
+		return (0);
+	p = realloc(*arr, n * size);
+	if (!p)
+		return (-1);
+	*arr = p;
+	*cap = n;
+	return (0);
+}
+
+/**
+ * compile_line - compiles one command line of a script
+ * @info: the shell state, whose token and node buffers are scratch
+ * @pg: the program
+ * @line: the line, without its newline
+ * @r: the length of the line
+ *
+ * The line is copied to the pool and parsed there, once, exactly as
+ * get_input() parses it when it reads it, so the compiled script runs
+ * the same commands in the same order. Nothing is kept of a line that
+ * runs on; the caller tries again with the next line added.
+ * Return: 0 on success, PARSE_MORE if the line runs on, -1 if memory
+ * ran out or the line is a syntax error, which is left to be reported
+ * when it is read
+ */
+static int compile_line(info_t *info, prog_t *pg, char *line, size_t r)
+{
+	linerec_t *l;
+	int n;
+
+	if (grow_array((void **)&pg->pool, &pg->pool_cap, pg->pool_len + r + 1,
+		1) == -1 || grow_array((void **)&pg->lines, &pg->line_cap,
+		pg->nlines + 1, sizeof(*l)) == -1)
+		return (-1);
+	l = pg->lines + pg->nlines;
+	l->text = pg->pool_len;
+	memcpy(pg->pool + l->text, line, r);
+	pg->pool[l->text + r] = 0;
+	info->line = pg->pool + l->text;
+	n = parse_line(info);
+	info->line = NULL;
+	if (n == PARSE_MORE || n == LEX_OPEN)
+		return (PARSE_MORE);
+	if ((n < 0 && n != PARSE_NONE) || grow_array((void **)&pg->toks,
+		&pg->tok_cap, pg->ntoks + info->ntok, sizeof(token_t)) == -1 ||
+		grow_array((void **)&pg->nodes, &pg->node_cap,
+		pg->nnodes + info->nnode, sizeof(node_t)) == -1)
+		return (-1);
+	l->tok = pg->ntoks;
+	l->ntok = info->ntok;
+	memcpy(pg->toks + l->tok, info->toks, sizeof(token_t) * l->ntok);
+	pg->ntoks += l->ntok;
+	l->node = pg->nnodes;
+	l->nnode = info->nnode;
+	memcpy(pg->nodes + l->node, info->nodes, sizeof(node_t) * l->nnode);
+	pg->nnodes += l->nnode;
+	pg->nlines++;
+	pg->pool_len += r + 1;
+	return (0);
+}
+
+/**
+ * compile_script - compiles the mapped script in info->src
+ * @info: the shell state structure
+ *
+ * Every command line is lexed and parsed once, before anything runs;
+ * a line that leaves a quote, group or operator open takes in the
+ * lines after it. Aliases and variables are still expanded when each
+ * command runs.
+ * Return: the compiled program, NULL if memory ran out or a line
+ * cannot be parsed
+ */
+prog_t *compile_script(info_t *info)
+{
+	prog_t *pg = malloc(sizeof(*pg));
+	char *line = info->src, *end = info->src + info->src_len, *nl, *from;
+	int r = pg ? 0 : -1;
+
+	if (pg)
+		_memset((char *)pg, 0, sizeof(*pg));
+	for (; !r && line < end; line = nl + 1)
+		for (from = line;; from = nl + 1)
+		{
+			nl = memchr(from, '\n', end - from);
+			if (!nl)
+				nl = end;
+			r = compile_line(info, pg, line, nl - line);
+			if (r != PARSE_MORE || nl == end)
+				break;
+		}
+	if (!r && pg->nlines)
+		return (pg);
+	if (pg)
+	{
+		free(pg->lines);
+		free(pg->toks);
+		free(pg->nodes);
+		free(pg->pool);
+		free(pg);
+	}
+	return (NULL);
+}
@@ -0,0 +1,54 @@
+#include "shell.h"
+
+/**
+ * map_script - maps a regular script file as the shell's input
+ * @info: the shell state, info->readfd is the open script
+ *
+ * The file is mapped private and writable, so input_buf() and
+ * node_text() can terminate lines in place and src_getline() hands
+ * out slices of the mapping without copying or reading. An anonymous
+ * page is reserved past the end of the file so the last line is
+ * always null-terminated, even when the file ends on a page boundary
+ * without a newline. The length is fixed when the script starts.
+ * Return: 0 if the script is mapped, -1 if it must be read instead
+ */
+int map_script(info_t *info)
+{
+	struct stat st;
+	size_t size;
+	char *p;
+
+	if (fstat(info->readfd, &st) == -1 || !S_ISREG(st.st_mode) ||
+		st.st_size <= 0)
+		return (-1);
+	size = st.st_size;
+	p = mmap(NULL, size + 1, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED)
+		return (-1);
+	if (mmap(p, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+		info->readfd, 0) == MAP_FAILED)
+	{
+		munmap(p, size + 1);
+		return (-1);
+	}
+	madvise(p, size, MADV_SEQUENTIAL);
+	info->src = p;
+	info->src_len = size;
+	info->src_pos = 0;
+	info->src_map = size + 1;
+	return (0);
+}
+
+/**
+ * unmap_script - releases the mapping made by map_script()
+ * @info: the shell state structure
+ */
+void unmap_script(info_t *info)
+{
+	if (!info->src_map)
+		return;
+	munmap(info->src, info->src_map);
+	info->src = NULL;
+	info->src_map = 0;
+}
@@ -0,0 +1,83 @@
+#include "shell.h"
+
+/**
+ * load_program - compiles the mapped script, or loads it from cache
+ * @info: the shell state, info->src being the mapped script
+ * @path: the script path
+ *
+ * With HSH_SCRIPT_CACHE set, the compiled form is kept in a file next
+ * to the script and reused for as long as the script's size and
+ * modification time stay the same. Once the script is compiled the
+ * mapping is no longer needed. If anything fails the script is read
+ * line by line as usual.
+ */
+void load_program(info_t *info, char *path)
+{
+	struct stat st;
+	int cache = _getenv(info, "HSH_SCRIPT_CACHE=") != NULL;
+
+	if (!info->src_map || fstat(info->readfd, &st) == -1)
+		return;
+	info->prog = cache ? load_cache(path, &st) : NULL;
+	if (!info->prog)
+	{
+		info->prog = compile_script(info);
+		if (info->prog && cache)
+			save_cache(info->prog, path, &st);
+	}
+	if (info->prog)
+		unmap_script(info);
+}
+
+/**
+ * prog_input - hands out the next line of the compiled script
+ * @info: the shell state structure
+ *
+ * Stands in for reading and parsing a line when a script is compiled:
+ * the line, its tokens and its tree come straight from their record,
+ * and the history and line count behave as they do when the script is
+ * read.
+ * Return: the root node of the line, PARSE_NONE if it holds no
+ * command, -1 once the script is done
+ */
+int prog_input(info_t *info)
+{
+	prog_t *pg = info->prog;
+	linerec_t *l = pg->lines + pg->pc;
+
+	if (pg->pc >= pg->nlines)
+		return (-1);
+	pg->pc++;
+	info->linecount_flag = 1;
+	info->line = pg->pool + l->text;
+	build_history_list(info, info->line, info->histcount++);
+	info->toks = pg->toks + l->tok;
+	info->ntok = l->ntok;
+	info->tok_pos = 0;
+	info->nodes = pg->nodes + l->node;
+	info->nnode = l->nnode;
+	return (l->nnode ? (int)l->nnode - 1 : PARSE_NONE);
+}
+
+/**
+ * free_program - releases the compiled script
+ * @info: the shell state structure
+ */
+void free_program(info_t *info)
+{
+	prog_t *pg = info->prog;
+
+	if (!pg)
+		return;
+	if (pg->blob)
+		munmap(pg->blob, pg->blob_len);
+	else
+	{
+		free(pg->lines);
+		free(pg->toks);
+		free(pg->nodes);
+		free(pg->pool);
+	}
+	free(pg);
+	info->prog = NULL;
+}
@@ -1,6 +1,8 @@
 #ifndef _SHELL_H_
 #define _SHELL_H_
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -8,21 +10,23 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
 #include <limits.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <signal.h>
+#include <spawn.h>
+#include <time.h>
+#include <dirent.h>
 
 /* for read/write buffers */
 #define READ_BUF_SIZE 1024
+#define READ_BLOCK_SIZE 65536
 #define WRITE_BUF_SIZE 1024
 #define BUF_FLUSH -1
 
-/* for command chaining */
-#define CMD_NORM	0
-#define CMD_OR		1
-#define CMD_AND		2
-#define CMD_CHAIN	3
-
 /* for convert_number() */
 #define CONVERT_LOWERCASE	1
 #define CONVERT_UNSIGNED	2
@@ -31,10 +35,147 @@
 #define USE_GETLINE 0
 #define USE_STRTOK 0
 
+/* for fork_cmd() launch backends */
+#define LAUNCH_FORK	0
+#define LAUNCH_SPAWN	1
+#define LAUNCH_VFORK	2
+#define LAUNCH_SERVER	3
+
+/* for the command location cache */
+#define CMD_HASH_SIZE	64
+#define CMD_HASH_NEG_TTL	2
+
+/* for the environment store */
+#define ENV_MIN_SLOTS	64
+#define ENV_TOMB	-1
+#define VAR_EXPORT	1
+#define VAR_READONLY	2
+#define VAR_INTEGER	4
+#define VAR_LOCAL	8
+
+/* for the alias table */
+#define ALIAS_HASH_SIZE	512
+
+/* for pathname expansion */
+#define GLOB_HASH_SIZE	64
+#define GLOB_DIRBUF_SIZE	(1 << 18)
+#define GLOB_ANY	256
+#define GLOB_STAR	257
+#define GLOB_SEP	258
+#define GLOB_END	259
+#define GLOB_CLASS	260
+
+/* for arithmetic expansion: the ops of a compiled expression, binary ops
+ * from A_MUL to A_LOR, then tokens the compiler alone sees */
+#define ARITH_HASH_SIZE	64
+#define ARITH_CACHE_MAX	256
+#define A_NUM		0
+#define A_VAR		1
+#define A_SET		2
+#define A_JZ		3
+#define A_JMP		4
+#define A_ANDJ		5
+#define A_ORJ		6
+#define A_BOOL		7
+#define A_POP		8
+#define A_NEG		9
+#define A_NOT		10
+#define A_INV		11
+#define A_MUL		12
+#define A_DIV		13
+#define A_MOD		14
+#define A_ADD		15
+#define A_SUB		16
+#define A_SHL		17
+#define A_SHR		18
+#define A_LT		19
+#define A_LE		20
+#define A_GT		21
+#define A_GE		22
+#define A_EQ		23
+#define A_NE		24
+#define A_AND		25
+#define A_XOR		26
+#define A_OR		27
+#define A_LAND		28
+#define A_LOR		29
+#define A_QUEST		30
+#define A_COLON		31
+#define A_LPAREN	32
+#define A_RPAREN	33
+#define A_COMMA		34
+#define A_END		35
+#define A_ASSIGN	64
+#define IS_ABINARY(op)	((op) >= A_MUL && (op) <= A_LOR)
+
+/* for the job table */
+#define JOBS_MAX	64
+#define JOB_RUNNING	1
+#define JOB_STOPPED	2
+#define JOB_DONE	3
+
+/* for parallel script mode */
+#define PARALLEL_MAX	256
+
+/* for compiled scripts */
+#define PROG_MAGIC	"HSC5"
+#define PROG_CACHE_EXT	".hshc"
+
+/* for the per-command arena and tokenize() */
+#define ARENA_BLOCK	4096
+#define IN_TABLE(t, c) \
+	((t)[(unsigned char)(c) >> 3] & (1 << ((unsigned char)(c) & 7)))
+
+/* for lex_line() tokens, separators first */
+#define TOK_WORD	0
+#define TOK_SEMI	1
+#define TOK_NEWLINE	2
+#define TOK_AMP		3
+#define TOK_AND		4
+#define TOK_OR		5
+#define TOK_PIPE	6
+#define TOK_LPAREN	7
+#define TOK_RPAREN	8
+#define TOK_LESS	9
+#define TOK_GREAT	10
+#define TOK_DGREAT	11
+#define TOK_LESSAND	12
+#define TOK_GREATAND	13
+#define TOK_LESSGREAT	14
+#define TOK_MAX		15
+#define IS_SEP(type)	((type) >= TOK_SEMI && (type) <= TOK_OR)
+#define IS_REDIR(type)	((type) >= TOK_LESS && (type) <= TOK_LESSGREAT)
+/* a simple command that fork_cmd() forks and execs redirects in the child */
+#define REDIR_IN_CHILD(info) ((info)->launch_mode == LAUNCH_FORK && \
+	!(info)->tail_ok && (info)->argc && !get_builtin((info)->argv[0]))
+#define TOK_AT(info) ((info)->tok_pos < (info)->ntok ? \
+	(info)->toks[(info)->tok_pos].type : -1)
+#define TF_QUOTED	1
+#define TF_DOLLAR	2
+#define TF_GLOB		4
+
+/* for the parsed command tree, binary nodes first */
+#define N_CMD		0
+#define N_PIPE		1
+#define N_AND		2
+#define N_OR		3
+#define N_SEQ		4
+#define N_BG		5
+#define N_GROUP		6
+#define N_SUBSHELL	7
+#define NF_TIMED	1
+#define PARSE_MORE	-2
+#define PARSE_ERR	-3
+#define PARSE_NONE	-4
+#define LEX_OPEN	-5
+
 #define HIST_FILE	".simple_shell_history"
 #define HIST_MAX	4096
 
 extern char **environ;
+extern const unsigned char word_delims[32];
+extern const unsigned char word_ends[32];
+extern const char * const tok_text[TOK_MAX];
 
 
 /**
@@ -50,6 +191,424 @@ typedef struct liststr
 	struct liststr *next;
 } list_t;
 
+/**
+ * struct cmdhash - command location cache entry
+ * @name: the command name as typed
+ * @path: the resolved path, NULL for a remembered failed lookup
+ * @stamp: when the lookup was made
+ * @hits: the number of times the entry was used
+ * @next: points to the next entry in the bucket
+ */
+typedef struct cmdhash
+{
+	char *name;
+	char *path;
+	time_t stamp;
+	int hits;
+	struct cmdhash *next;
+} cmdhash_t;
+
+/**
+ * struct job - background job table entry
+ * @id: the job number, 0 for a free slot
+ * @pgid: the process group of the job's processes
+ * @pid: the last process of the job, whose status is the job's
+ * @nprocs: the number of processes not yet reaped
+ * @state: JOB_RUNNING, JOB_STOPPED or JOB_DONE
+ * @status: the exit status once the job is done
+ * @cmd: the command line that started the job
+ */
+typedef struct job
+{
+	int id;
+	pid_t pgid;
+	pid_t pid;
+	int nprocs;
+	int state;
+	int status;
+	char *cmd;
+} job_t;
+
+/**
+ * struct cmdstats - resource usage of a command, times in microseconds
+ * @start_us: monotonic clock when the command was launched
+ * @real_us: wall clock time the command took
+ * @user_us: user CPU time of its processes
+ * @sys_us: system CPU time of its processes
+ * @maxrss: largest resident set size of its processes, in kilobytes
+ * @nvcsw: voluntary context switches
+ * @nivcsw: involuntary context switches
+ */
+typedef struct cmdstats
+{
+	long start_us;
+	long real_us;
+	long user_us;
+	long sys_us;
+	long maxrss;
+	long nvcsw;
+	long nivcsw;
+} cmdstats_t;
+
+/**
+ * struct srvreq - header of a fork-server launch request
+ * @len: the number of payload bytes that follow the header
+ * @argc: the number of argv strings in the payload
+ * @envc: the number of environment strings in the payload
+ *
+ * The payload is cwd, path, argv and envp as consecutive
+ * null-terminated strings; stdin, stdout and stderr travel with the
+ * header as SCM_RIGHTS.
+ */
+typedef struct srvreq
+{
+	size_t len;
+	int argc;
+	int envc;
+} srvreq_t;
+
+/**
+ * struct srvreply - fork-server reply once the command has exited
+ * @status: the wait status of the command
+ * @ru: the resource usage of the command
+ */
+typedef struct srvreply
+{
+	int status;
+	struct rusage ru;
+} srvreply_t;
+
+/**
+ * struct worker - a script line running in a parallel worker
+ * @pid: the worker process, 0 for a free slot
+ * @lineno: the script line the worker runs
+ * @out: memfd holding the worker's stdout
+ * @err: memfd holding the worker's stderr
+ * @status: the worker's exit status once it has been reaped
+ * @done: on once the worker has been reaped
+ */
+typedef struct worker
+{
+	pid_t pid;
+	unsigned int lineno;
+	int out;
+	int err;
+	int status;
+	int done;
+} worker_t;
+
+/**
+ * struct arenablk - header of a block of the per-command arena
+ * @next: the block started before this one
+ * @size: the number of bytes following the header
+ * @used: the number of those bytes handed out
+ */
+typedef struct arenablk
+{
+	struct arenablk *next;
+	size_t size;
+	size_t used;
+} arenablk_t;
+
+/**
+ * struct token - one token of a command line
+ * @start: the offset of the token in its line
+ * @len: its length in the line, quotes and backslashes included
+ * @type: TOK_WORD or the operator
+ * @flags: for a word, TF_QUOTED if it holds quotes or backslashes,
+ * TF_DOLLAR if it holds an unquoted or double-quoted $, TF_GLOB if it
+ * holds an unquoted *, ? or [
+ * @fd: the file descriptor written in front of a redirection, else -1
+ */
+typedef struct token
+{
+	unsigned int start;
+	unsigned int len;
+	unsigned char type;
+	unsigned char flags;
+	short fd;
+} token_t;
+
+/**
+ * struct globpat - a pathname pattern compiled by glob_compile()
+ * @ops: one op per pattern character: a byte value for a literal,
+ * GLOB_ANY for ?, GLOB_STAR for *, GLOB_CLASS + k for bracket
+ * expression k, GLOB_SEP for a / and GLOB_END at the end
+ * @cls: the bracket expressions, as 256-bit tables of the bytes each
+ * one matches
+ */
+typedef struct globpat
+{
+	unsigned short *ops;
+	unsigned char (*cls)[32];
+} globpat_t;
+
+/**
+ * struct globdir - a directory listing kept for pathname expansion
+ * @dev: the device of the directory
+ * @ino: its inode
+ * @mtime: its modification time when it was read
+ * @names: the entries but . and .., each a d_type byte then the
+ * null-terminated name
+ * @len: the bytes used in names
+ * @next: points to the next listing in the bucket
+ */
+typedef struct globdir
+{
+	dev_t dev;
+	ino_t ino;
+	struct timespec mtime;
+	char *names;
+	size_t len;
+	struct globdir *next;
+} globdir_t;
+
+/**
+ * struct arithop - one op of a compiled arithmetic expression
+ * @op: the A_ op
+ * @val: the number of A_NUM, the offset of the name in the names of
+ * A_VAR and A_SET, the op to go on at for A_JZ, A_JMP, A_ANDJ and A_ORJ
+ */
+typedef struct arithop
+{
+	int op;
+	long val;
+} arithop_t;
+
+/**
+ * struct arith - an arithmetic expression compiled to postfix ops
+ * @text: the expression, which is the key in the cache
+ * @len: its length
+ * @hash: the hash of the text
+ * @ops: the ops, run from first to last on a stack of numbers
+ * @nops: the number of ops
+ * @names: the null-terminated names of the variables the ops use
+ * @next: points to the next expression in the bucket
+ */
+typedef struct arith
+{
+	char *text;
+	size_t len;
+	unsigned int hash;
+	arithop_t *ops;
+	int nops;
+	char *names;
+	struct arith *next;
+} arith_t;
+
+/**
+ * struct arithc - the state of arith_expr() while it compiles
+ * @s: the text not yet read
+ * @end: the end of the text
+ * @tok: the A_ token just read, with A_ASSIGN added for an assignment
+ * @num: the value of an A_NUM token, or for an A_VAR token the offset
+ * of its name in names
+ * @ops: the ops compiled so far
+ * @nops: their number
+ * @names: the names of the variables met so far
+ * @used: the bytes used in names
+ * @err: what is wrong with the expression, NULL while nothing is
+ */
+typedef struct arithc
+{
+	char *s;
+	char *end;
+	int tok;
+	long num;
+	arithop_t *ops;
+	int nops;
+	char *names;
+	size_t used;
+	char *err;
+} arithc_t;
+
+/**
+ * struct envvar - one variable of the environment store
+ * @str: the variable as NAME=value, NULL once it is unset
+ * @nlen: the length of the name
+ * @hash: the hash of the name
+ * @pos: the slot of str in the store's envp, if it is exported
+ * @flags: VAR_EXPORT, VAR_READONLY and VAR_INTEGER
+ */
+typedef struct envvar
+{
+	char *str;
+	size_t nlen;
+	unsigned int hash;
+	size_t pos;
+	int flags;
+} envvar_t;
+
+/**
+ * struct envstore - the environment, hashed by name
+ * @vars: the variables in the order they were first set, with holes
+ * where variables were unset
+ * @n: the entries used in vars, holes included
+ * @live: the variables that are set
+ * @cap: the entries vars has room for
+ * @index: open-addressing table of the variables: for each slot 0 if
+ * it is empty, ENV_TOMB if its variable was unset, else the index + 1
+ * of the variable in vars
+ * @icap: the number of slots, a power of two
+ * @used: the slots that are not empty, tombstones included
+ * @envp: the strs of the exported variables as the null-terminated
+ * array execve() takes, kept up to date as variables change; room for
+ * cap + 1 pointers
+ * @nexp: the exported variables, whose strs are in envp
+ */
+typedef struct envstore
+{
+	envvar_t *vars;
+	size_t n;
+	size_t live;
+	size_t cap;
+	int *index;
+	size_t icap;
+	size_t used;
+	char **envp;
+	size_t nexp;
+} envstore_t;
+
+/**
+ * struct localvar - a variable as it was before local changed it
+ * @str: the variable as NAME=value, just NAME if it was not set
+ * @nlen: the length of the name
+ * @flags: its VAR_ flags
+ * @scope: the group nesting local was run at
+ * @next: the variable local changed before this one
+ */
+typedef struct localvar
+{
+	char *str;
+	size_t nlen;
+	int flags;
+	int scope;
+	struct localvar *next;
+} localvar_t;
+
+/**
+ * struct alias - alias table entry
+ * @node: the alias in info->alias, whose str is name=value
+ * @nlen: the length of the name
+ * @toks: the tokens of the value, lexed when the alias is set
+ * @ntok: the number of tokens in toks
+ * @gen: the alias_gen of the last command the alias was expanded in
+ * @next: points to the next entry in the bucket
+ */
+typedef struct alias
+{
+	list_t *node;
+	size_t nlen;
+	token_t *toks;
+	int ntok;
+	unsigned int gen;
+	struct alias *next;
+} alias_t;
+
+/**
+ * struct node - one node of a parsed command line
+ * @type: the N_ type
+ * @flags: NF_TIMED for a pipeline run with the time keyword
+ * @tok: the index of the first token the node spans
+ * @ntok: the number of tokens it spans
+ * @a: the left operand, or the only one of N_BG, N_GROUP and N_SUBSHELL
+ * @b: the right operand of N_PIPE, N_AND, N_OR and N_SEQ; for N_CMD,
+ * N_GROUP and N_SUBSHELL the index of the token its redirections start
+ * at, which for N_CMD is its first token
+ *
+ * Operands are indexes of nodes that come before this one, so the
+ * last node of a line is its root.
+ */
+typedef struct node
+{
+	unsigned char type;
+	unsigned char flags;
+	unsigned int tok;
+	unsigned int ntok;
+	int a;
+	int b;
+} node_t;
+
+/**
+ * struct linerec - one line of a compiled script
+ * @text: offset in the pool of the line
+ * @tok: index in the program's tokens of the line's first token
+ * @ntok: the number of tokens in the line
+ * @node: index in the program's nodes of the line's first node
+ * @nnode: the number of nodes in the line
+ *
+ * A line runs on when a quote, group or operator is left open at its
+ * end, so its text can hold newlines.
+ */
+typedef struct linerec
+{
+	unsigned int text;
+	unsigned int tok;
+	unsigned int ntok;
+	unsigned int node;
+	unsigned int nnode;
+} linerec_t;
+
+/**
+ * struct proghdr - header of a compiled script cache file
+ * @magic: PROG_MAGIC, which changes with the format
+ * @nlines: the number of line records that follow
+ * @ntoks: the number of tokens that follow the line records
+ * @nnodes: the number of nodes that follow the tokens
+ * @size: the size of the script when it was compiled
+ * @mtime: the modification time of the script, seconds
+ * @mtime_ns: the modification time of the script, nanoseconds
+ * @pool_len: the number of pool bytes after the nodes
+ */
+typedef struct proghdr
+{
+	char magic[4];
+	unsigned int nlines;
+	unsigned int ntoks;
+	unsigned int nnodes;
+	long size;
+	long mtime;
+	long mtime_ns;
+	unsigned long pool_len;
+} proghdr_t;
+
+/**
+ * struct prog - a compiled script
+ * @lines: the line records, in script order
+ * @nlines: the number of records
+ * @line_cap: the number of records lines has room for while compiling
+ * @pc: the next line to run
+ * @toks: the tokens of every line, one line after the other
+ * @ntoks: the number of tokens
+ * @tok_cap: the number of tokens toks has room for while compiling
+ * @nodes: the nodes of every line, one line after the other
+ * @nnodes: the number of nodes
+ * @node_cap: the number of nodes nodes has room for while compiling
+ * @pool: the text of the lines, which the tokens point into
+ * @pool_len: the bytes used in the pool
+ * @pool_cap: the size of the pool while compiling
+ * @blob: the mapped cache file the rest lives in, NULL if compiled
+ * @blob_len: the length of the mapping
+ */
+typedef struct prog
+{
+	linerec_t *lines;
+	unsigned int nlines;
+	size_t line_cap;
+	unsigned int pc;
+	token_t *toks;
+	unsigned int ntoks;
+	size_t tok_cap;
+	node_t *nodes;
+	unsigned int nnodes;
+	size_t node_cap;
+	char *pool;
+	size_t pool_len;
+	size_t pool_cap;
+	char *blob;
+	size_t blob_len;
+} prog_t;
+
 /**
  *struct passinfo - contains pseudo-arguements to pass into a function,
  *		allowing uniform prototype for function pointer struct
@@ -61,16 +620,62 @@ typedef struct liststr
  *@err_num: the error code for exit()s
  *@linecount_flag: if on count this line of input
  *@fname: the program filename
- *@env: linked list local copy of environ
- *@environ: custom modified copy of environ from LL env
+ *@env: the shell variables, hashed by name, the exported ones
+ *making up the environment of commands
  *@history: the history node
  *@alias: the alias node
- *@env_changed: on if environ was changed
  *@status: the return status of the last exec'd command
  *@cmd_buf: address of pointer to cmd_buf, on if chaining
- *@cmd_buf_type: CMD_type ||, &&, ;
  *@readfd: the fd from which to read line input
  *@histcount: the history line number count
+ *@launch_mode: LAUNCH_ backend used by fork_cmd()
+ *@cmd_hash: buckets of the command location cache
+ *@pipefail: on if a pipeline fails when any of its stages fails
+ *@jobs: the job table, JOBS_MAX entries
+ *@last_bg: pid of the last background command, for $!
+ *@read_pending: bytes read from readfd not yet returned by _getline()
+ *@tail_ok: on if the current command is the last input there will be
+ *@cmdstats: on to print a stats line after every external command
+ *@stats: resource usage of the last external command or pipeline
+ *@timing: clock and CPU times when the timed command started
+ *@server_fd: socket to the fork-server, 0 if it is not running
+ *@server_pid: pid of the fork-server
+ *@src: in-memory input read instead of readfd, NULL if none
+ *@src_len: the length of src
+ *@src_pos: how much of src _getline() has handed out
+ *@parallel: the number of parallel workers for script lines, 0 if off
+ *@src_map: the length of the mapping if src is a mapped script, else 0
+ *@posv: the positional parameters, posv[0] being $0
+ *@posc: the number of entries in posv
+ *@prog: the compiled script being run, NULL if input is read
+ *@arena: blocks holding argv and its words, reset after every command
+ *@line: the line the tokens in toks point into
+ *@toks: the tokens of line
+ *@ntok: the number of tokens in toks
+ *@tok_pos: the token the parser is at
+ *@cmd_toks: the tokens of the current command
+ *@cmd_ntok: the number of tokens in cmd_toks
+ *@tok_buf: the tokens lex_line() fills in, reused for every line
+ *@tok_cap: the number of tokens tok_buf has room for
+ *@nodes: the parsed tree of line, its root last
+ *@nnode: the number of nodes in nodes
+ *@node_buf: the nodes parse_line() fills in, reused for every line
+ *@node_cap: the number of nodes node_buf has room for
+ *@xbuf: the buffer expand_word() builds words in, reused for every word
+ *@xlen: the bytes used in xbuf
+ *@xcap: the size of xbuf
+ *@alias_hash: buckets of the alias table, indexing info->alias
+ *@alias_gen: counts the commands aliases were expanded in
+ *@glob_cache: buckets of the directory listings read for pathname
+ *expansion on this command line
+ *@arith_hash: buckets of the compiled arithmetic expressions
+ *@arith_count: the number of expressions in arith_hash
+ *@scope: how many { } groups deep the shell is running
+ *@locals: the variables local changed, the latest first, to put back
+ *as their groups end
+ *@redir_high: the redirections of fds above 2 in force in the shell,
+ *which the fork-server cannot pass on
+ *@shell_pid: the pid of the shell, for $$, which subshells keep
  */
 typedef struct passinfo
 {
@@ -82,45 +687,273 @@ typedef struct passinfo
 	int err_num;
 	int linecount_flag;
 	char *fname;
-	list_t *env;
+	envstore_t env;
 	list_t *history;
 	list_t *alias;
-	char **environ;
-	int env_changed;
 	int status;
 
 	char **cmd_buf; /* pointer to cmd ; chain buffer, for memory mangement */
-	int cmd_buf_type; /* CMD_type ||, &&, ; */
 	int readfd;
 	int histcount;
+	int launch_mode;
+	cmdhash_t **cmd_hash;
+	int pipefail;
+	job_t *jobs;
+	pid_t last_bg;
+	size_t read_pending;
+	int tail_ok;
+	int cmdstats;
+	cmdstats_t stats;
+	cmdstats_t timing;
+	int server_fd;
+	pid_t server_pid;
+	char *src;
+	size_t src_len;
+	size_t src_pos;
+	int parallel;
+	size_t src_map;
+	char **posv;
+	int posc;
+	prog_t *prog;
+	arenablk_t *arena;
+	char *line;
+	token_t *toks;
+	int ntok;
+	int tok_pos;
+	token_t *cmd_toks;
+	int cmd_ntok;
+	token_t *tok_buf;
+	size_t tok_cap;
+	node_t *nodes;
+	int nnode;
+	node_t *node_buf;
+	size_t node_cap;
+	char *xbuf;
+	size_t xlen;
+	size_t xcap;
+	alias_t **alias_hash;
+	unsigned int alias_gen;
+	globdir_t **glob_cache;
+	arith_t **arith_hash;
+	int arith_count;
+	int scope;
+	localvar_t *locals;
+	int redir_high;
+	pid_t shell_pid;
 } info_t;
 
 #define INFO_INIT \
-{NULL, NULL, NULL, 0, 0, 0, 0, NULL, NULL, NULL, NULL, NULL, 0, 0, NULL, \
-	0, 0, 0}
+{NULL, NULL, NULL, 0, 0, 0, 0, NULL, \
+	{NULL, 0, 0, 0, NULL, 0, 0, NULL, 0}, NULL, NULL, 0, NULL, 0, 0, \
+	LAUNCH_FORK, NULL, 0, NULL, 0, 0, 0, 0, \
+	{0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0}, 0, 0, NULL, 0, 0, 0, \
+	0, NULL, 0, NULL, NULL, NULL, NULL, 0, 0, NULL, 0, NULL, 0, \
+	NULL, 0, NULL, 0, NULL, 0, 0, NULL, 0, NULL, NULL, 0, 0, NULL, 0, 0}
 
 /**
  *struct builtin - contains a builtin string and related function
  *@type: the builtin command flag
  *@func: the function
+ *@pure: on if the builtin only prints and changes nothing, so $(...)
+ *can run it in the shell instead of forking
  */
 typedef struct builtin
 {
 	char *type;
 	int (*func)(info_t *);
+	int pure;
 } builtin_table;
 
 
 /* loop.c */
 int hsh(info_t *, char **);
+int run_node(info_t *, char **, int, int);
 int find_builtin(info_t *);
 void find_cmd(info_t *);
 void fork_cmd(info_t *);
 
+/* launch_backends.c */
+pid_t spawn_cmd(info_t *);
+pid_t vfork_cmd(info_t *);
+void wait_cmd(info_t *, pid_t);
+void finish_cmd(info_t *, struct rusage *);
+
+/* launch_builtin.c */
+int set_launch_mode(info_t *, char *);
+int _mylaunch(info_t *);
+
+/* fork_server.c */
+int start_fork_server(info_t *);
+int server_cmd(info_t *);
+void stop_fork_server(info_t *);
+
+/* fork_server_io.c */
+int read_full(int, void *, size_t);
+int write_all(int, void *, size_t);
+char *pack_request(info_t *, srvreq_t *);
+int send_request(int, srvreq_t *, char *);
+
+/* builtin_lookup.c */
+builtin_table *get_builtin(char *);
+int builtin_init(void);
+
+/* tail_exec.c */
+int input_at_eof(info_t *);
+void tail_exec(info_t *);
+
+/* input_source.c */
+int src_getline(info_t *, char **);
+
+/* script_compile.c */
+prog_t *compile_script(info_t *);
+
+/* script_cache.c */
+prog_t *load_cache(char *, struct stat *);
+void save_cache(prog_t *, char *, struct stat *);
+
+/* script_program.c */
+void load_program(info_t *, char *);
+int prog_input(info_t *);
+void free_program(info_t *);
+
+/* script_map.c */
+int map_script(info_t *);
+void unmap_script(info_t *);
+
+/* positional_params.c */
+int replace_param(info_t *, int *);
+char *param_value(info_t *, char *, size_t);
+
+/* param_expand.c */
+int xbuf_put(info_t *, char *, size_t);
+int xbuf_read(info_t *, int);
+void xbuf_split(info_t *, size_t);
+int expand_text(info_t *, char *, char *, int);
+char *expand_word(info_t *, char *);
+
+/* param_subst.c */
+char *expand_param(info_t *, char *, int);
+
+/* redirect.c */
+int redirect(info_t *, token_t *, int, int **);
+void undo_redirect(info_t *, int *);
+
+/* cmd_subst.c */
+char *cmd_subst(info_t *, char *, int);
+
+/* parallel_script.c */
+int run_parallel(info_t *, char **);
+
 /* parser.c */
 int is_cmd(info_t *, char *);
 char *dup_chars(char *, int, int);
 char *find_path(info_t *, char *, char *);
+char *locate_cmd(info_t *);
+
+/* command_lexer.c */
+int lex_line(info_t *, char *);
+token_t *lex_copy(info_t *, char *, int *);
+
+/* command_parser.c */
+int parse_list(info_t *, int);
+
+/* command_chain.c */
+int new_node(info_t *, int, int, int, int);
+int parse_line(info_t *);
+void parse_error(info_t *, int);
+char *node_text(info_t *, node_t *);
+void syntax_error(info_t *, char *);
+
+/* pipeline.c */
+int *split_pipeline(info_t *, int, int *);
+pid_t start_stage(info_t *, char **, int, int, int *, pid_t *);
+int wait_pipeline(info_t *, pid_t *, int);
+int run_pipeline(info_t *, char **, int);
+
+/* job_table.c */
+job_t *add_job(info_t *, pid_t, pid_t, int, char *);
+job_t *find_job(info_t *, char *);
+void update_job(job_t *, pid_t, int);
+int reap_jobs(info_t *, int);
+int wait_job(job_t *);
+
+/* job_control.c */
+int init_job_control(info_t *);
+int drain_sigchld(void);
+void free_job(job_t *);
+void free_jobs(info_t *);
+
+/* job_report.c */
+void print_job(info_t *, job_t *);
+int notify_jobs(info_t *);
+int background_job(info_t *, pid_t, pid_t *, int, char *);
+
+/* job_builtins.c */
+int _myjobs(info_t *);
+int _mywait(info_t *);
+int _myfg(info_t *);
+int _mybg(info_t *);
+
+/* kill_builtin.c */
+int sig_from_name(char *);
+int _mykill(info_t *);
+
+/* cmd_stats.c */
+long now_us(void);
+void stats_begin(info_t *);
+void stats_add(info_t *, struct rusage *);
+void stats_end(info_t *);
+void print_duration(long, int);
+
+/* time_builtins.c */
+void time_prefix(info_t *);
+void time_report(info_t *);
+int _mytimes(info_t *);
+
+/* shell_options.c */
+int _myset(info_t *);
+
+/* cmd_hash.c */
+cmdhash_t *cmd_hash_entry(info_t *, char *);
+cmdhash_t *cmd_hash_store(info_t *, char *, char *);
+char *cmd_hash_find(info_t *, char *, char *);
+void cmd_hash_clear(info_t *);
+
+/* alias_table.c */
+alias_t *alias_find(info_t *, char *, size_t);
+int alias_store(info_t *, char *, token_t *, int);
+int alias_remove(info_t *, char *, size_t);
+void alias_clear(info_t *);
+
+/* glob_match.c */
+int glob_compile(info_t *, char *, size_t, int, globpat_t *);
+int glob_match(unsigned short *, char *, unsigned char (*)[32]);
+
+/* glob_dir.c */
+globdir_t *glob_dir(info_t *, char *);
+void glob_clear(info_t *);
+
+/* glob_expand.c */
+int glob_word(info_t *, char *, size_t, int);
+
+/* arith_lex.c */
+void arith_next(arithc_t *);
+
+/* arith_compile.c */
+void arith_expr(arithc_t *);
+
+/* arith_eval.c */
+int arith_eval(info_t *, char *, size_t, int, long *);
+
+/* arith_builtin.c */
+void arith_error(info_t *, char *, char *, size_t);
+char *arith_subst(info_t *, char *, int);
+int _mylet(info_t *);
+void arith_clear(info_t *);
+
+/* hash_builtin.c */
+int print_cmd_hash(info_t *);
+int _myhash(info_t *);
 
 /* hsh.c */
 int loophsh(char **);
@@ -148,9 +981,17 @@ char *_strncpy(char *, char *, int);
 char *_strncat(char *, char *, int);
 char *_strchr(char *, char);
 
-/* tokenizer.c */
-char **strtow(char *, char *);
-char **strtow2(char *, char);
+/* command_tokenizer.c */
+char **tokenize(info_t *, token_t *, int);
+char *subst_end(char *);
+char *brace_end(char *);
+
+/* arena.c */
+void *arena_alloc(info_t *, size_t);
+char *arena_dup(info_t *, char *);
+int replace_arg(info_t *, int, char *);
+void arena_reset(info_t *);
+void arena_free(info_t *);
 
 /* realloc.c */
 char *_memset(char *, char, unsigned int);
@@ -159,6 +1000,7 @@ void *_realloc(void *, unsigned int, unsigned int);
 
 /* memory.c */
 int bfree(void **);
+int grow_line(char **, size_t *, size_t);
 
 /* atoi.c */
 int interactive(info_t *);
@@ -171,7 +1013,6 @@ int _erratoi(char *);
 void print_error(info_t *, char *);
 int print_d(int, int);
 char *convert_number(long int, int, int);
-void remove_comments(char *);
 
 /* builtin.c */
 int _myexit(info_t *);
@@ -181,16 +1022,17 @@ int _myhelp(info_t *);
 /* builtin1.c */
 int _myhistory(info_t *);
 int _myalias(info_t *);
+int print_alias(list_t *);
 
 
 /*getline.c */
-ssize_t get_input(info_t *);
+int get_input(info_t *);
 int _getline(info_t *, char **, size_t *);
 void sigintHandler(int);
 
 /*getinfo.c */
 void clear_info(info_t *);
-void set_info(info_t *, char **);
+int set_info(info_t *, char **);
 void free_info(info_t *, int);
 
 /* environ.c */
@@ -204,6 +1046,31 @@ int populate_env_list(info_t *);
 char **get_environ(info_t *);
 int _unsetenv(info_t *, char *);
 int _setenv(info_t *, char *, char *);
+void env_free(info_t *);
+void env_flags(info_t *, envvar_t *, int);
+
+/* env_store.c */
+envvar_t *env_find(info_t *, char *, size_t);
+envvar_t *env_set(info_t *, char *, size_t);
+int env_unset(info_t *, char *, size_t);
+
+/* shell_vars.c */
+void var_error(info_t *, char *, size_t, char *);
+int var_set(info_t *, char *, char *, int);
+int var_unset(info_t *, char *);
+int var_declare(info_t *, char *, int, int);
+void var_print(info_t *, int);
+
+/* var_builtins.c */
+int _myexport(info_t *);
+int _myreadonly(info_t *);
+int _mylocal(info_t *);
+int _myunset(info_t *);
+
+/* var_scope.c */
+int local_save(info_t *, char *, size_t);
+void local_pop(info_t *);
+void local_free(info_t *);
 
 /* history.c */
 char *get_history_file(info_t *info);
@@ -227,10 +1094,7 @@ list_t *node_starts_with(list_t *, char *, char);
 ssize_t get_node_index(list_t *, list_t *);
 
 /* vars.c */
-int is_chain(info_t *, char *, size_t *);
-void check_chain(info_t *, char *, size_t *, size_t, size_t);
 int replace_alias(info_t *);
 int replace_vars(info_t *);
-int replace_string(char **, char *);
 
 #endif
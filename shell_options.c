@@ -0,0 +1,74 @@
+#include "shell.h"
+
+/**
+ * option_flag - finds the info field behind a shell option name
+ * @info: the shell state structure
+ * @name: the option name, or NULL to get the index-th option
+ * @index: the option to return when name is NULL
+ * @optname: set to the name of the option found
+ *
+ * Return: the address of the option's flag, or NULL if there is none
+ */
+static int *option_flag(info_t *info, char *name, int index, char **optname)
+{
+	char *names[] = {"cmdstats", "pipefail", NULL};
+	int *flags[2];
+	int i;
+
+	flags[0] = &info->cmdstats;
+	flags[1] = &info->pipefail;
+	for (i = 0; names[i]; i++)
+		if (name ? !_strcmp(name, names[i]) : i == index)
+		{
+			*optname = names[i];
+			return (flags[i]);
+		}
+	return (NULL);
+}
+
+/**
+ * _myset - mimics the set -o/+o builtin for the shell's options
+ * @info: Structure containing potential arguments. Used to maintain
+ *          constant function prototype.
+ *
+ * "set -o name" turns an option on, "set +o name" turns it off and
+ * "set -o" alone lists the options: cmdstats and pipefail. The status
+ * is 2 on an unknown option, 0 otherwise.
+ * Return: 0 on success, 1 on an unknown option
+ */
+int _myset(info_t *info)
+{
+	int on, i, *flag;
+	char *name;
+
+	info->status = 0;
+	if (info->argc == 1 ||
+		(info->argc == 2 && !_strcmp(info->argv[1], "-o")))
+	{
+		for (i = 0; (flag = option_flag(info, NULL, i, &name)); i++)
+		{
+			_puts(name);
+			_puts(*flag ? "\ton\n" : "\toff\n");
+		}
+		return (0);
+	}
+	on = !_strcmp(info->argv[1], "-o");
+	if ((!on && _strcmp(info->argv[1], "+o")) || info->argc != 3)
+	{
+		print_error(info, "Illegal option ");
+		_eputs(info->argv[1]);
+		_eputchar('\n');
+		info->status = 2;
+		return (1);
+	}
+	flag = option_flag(info, info->argv[2], 0, &name);
+	if (!flag)
+	{
+		print_error(info, info->argv[2]);
+		_eputs(": invalid option name\n");
+		info->status = 2;
+		return (1);
+	}
+	*flag = on;
+	return (0);
+}
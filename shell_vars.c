@@ -0,0 +1,170 @@
+#include "shell.h"
+
+/**
+ * var_error - says what is wrong with a variable
+ * @info: the shell state structure
+ * @name: the variable's name, which need not be null-terminated
+ * @n: the length of the name
+ * @msg: what is wrong
+ */
+void var_error(info_t *info, char *name, size_t n, char *msg)
+{
+	size_t i;
+
+	info->line_count += info->linecount_flag == 1;
+	info->linecount_flag = 0;
+	_eputs(info->fname);
+	_eputs(": ");
+	print_d(info->line_count, STDERR_FILENO);
+	_eputs(": ");
+	for (i = 0; i < n; i++)
+		_eputchar(name[i]);
+	_eputs(": ");
+	_eputs(msg);
+	_eputchar('\n');
+}
+
+/**
+ * var_set - sets a shell variable
+ * @info: the shell state structure
+ * @name: the variable's name
+ * @value: its value
+ * @flags: VAR_ flags to give it on top of those it has; a new variable
+ * has none but these, so it is not exported unless they say so
+ *
+ * The value of an integer variable is evaluated as an arithmetic
+ * expression, and the variable set to the number. Setting PATH empties
+ * the command location cache.
+ * Return: 0 on success, -1 if the variable is read-only, the value no
+ * valid expression or memory ran out, after saying which
+ */
+int var_set(info_t *info, char *name, char *value, int flags)
+{
+	size_t n = _strlen(name);
+	envvar_t *v = env_find(info, name, n);
+	char *buf;
+	long x;
+
+	if (v && (v->flags & VAR_READONLY))
+		return (var_error(info, name, n, "is read only"), -1);
+	if ((flags | (v ? v->flags : 0)) & VAR_INTEGER)
+	{
+		if (arith_eval(info, value, _strlen(value), 0, &x))
+			return (-1);
+		value = convert_number(x, 10, 0);
+	}
+	if (n == 4 && !_strcmp(name, "PATH"))
+		cmd_hash_clear(info);
+	buf = malloc(n + _strlen(value) + 2);
+	if (!buf)
+		return (_eputs("hsh: out of memory\n"), -1);
+	_strcpy(buf, name);
+	_strcat(buf, "=");
+	_strcat(buf, value);
+	v = env_set(info, buf, n);
+	if (!v)
+	{
+		free(buf);
+		return (_eputs("hsh: out of memory\n"), -1);
+	}
+	env_flags(info, v, v->flags | flags);
+	return (0);
+}
+
+/**
+ * var_unset - unsets a shell variable
+ * @info: the shell state structure
+ * @name: the variable's name
+ *
+ * Return: 1 if the variable was unset, 0 if it was not set, -1 if it is
+ * read-only, after saying so
+ */
+int var_unset(info_t *info, char *name)
+{
+	size_t n = _strlen(name);
+	envvar_t *v = env_find(info, name, n);
+
+	if (v && (v->flags & VAR_READONLY))
+		return (var_error(info, name, n, "is read only"), -1);
+	if (n == 4 && !_strcmp(name, "PATH"))
+		cmd_hash_clear(info);
+	return (env_unset(info, name, n));
+}
+
+/**
+ * var_declare - gives a variable flags, and maybe a value, as export,
+ * readonly and local do
+ * @info: the shell state structure
+ * @arg: the argument, NAME or NAME=value
+ * @flags: the VAR_ flags to give it; with VAR_LOCAL, what it was is
+ * saved first, to be put back when the group it is local to ends
+ * @off: the VAR_ flags to take from it
+ *
+ * A variable given no value keeps the one it has; if it has none, or is
+ * made local, it is set to the empty string.
+ * Return: 0 on success, -1 on an error, after saying what it was
+ */
+int var_declare(info_t *info, char *arg, int flags, int off)
+{
+	char *p = arg, c;
+	envvar_t *v;
+	size_t n;
+	int ret = 0;
+
+	while (_isalpha(*p) || *p == '_' || (p > arg && *p >= '0' && *p <= '9'))
+		p++;
+	n = p - arg;
+	c = *p;
+	if (!n || (c && c != '='))
+		return (var_error(info, arg, _strlen(arg),
+			"not a valid identifier"), -1);
+	v = env_find(info, arg, n);
+	if ((flags & VAR_LOCAL) && v && (v->flags & VAR_READONLY))
+		return (var_error(info, arg, n, "is read only"), -1);
+	if ((flags & VAR_LOCAL) && local_save(info, arg, n))
+		return (_eputs("hsh: out of memory\n"), -1);
+	if (c || !v || (flags & VAR_LOCAL))
+	{
+		*p = 0;
+		ret = var_set(info, arg, c ? p + 1 : p, flags & ~VAR_LOCAL);
+		*p = c;
+	}
+	v = ret ? NULL : env_find(info, arg, n);
+	if (v)
+		env_flags(info, v, (v->flags | flags) & ~off & ~VAR_LOCAL);
+	return (ret);
+}
+
+/**
+ * var_print - lists the variables with some flags, as export and
+ * readonly with no arguments do
+ * @info: the shell state, whose argv[0] each line starts with
+ * @flags: the VAR_ flags, any of which a variable must have
+ *
+ * Each line is one the shell can read back, in the order the variables
+ * were first set: the value is single-quoted, a ' in it written '\''.
+ */
+void var_print(info_t *info, int flags)
+{
+	envvar_t *v;
+	size_t i, k;
+	char *p;
+
+	for (i = 0; i < info->env.n; i++)
+	{
+		v = info->env.vars + i;
+		if (!v->str || !(v->flags & flags))
+			continue;
+		_puts(info->argv[0]);
+		_putchar(' ');
+		for (k = 0; k <= v->nlen; k++)
+			_putchar(v->str[k]);
+		_putchar('\'');
+		for (p = v->str + v->nlen + 1; *p; p++)
+			if (*p == '\'')
+				_puts("'\\''");
+			else
+				_putchar(*p);
+		_puts("'\n");
+	}
+}
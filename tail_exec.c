@@ -0,0 +1,51 @@
+#include "shell.h"
+
+/**
+ * input_at_eof - tells whether no more input will follow
+ * @info: the shell state structure
+ *
+ * Only a compiled script, in-memory input or a non-interactive shell
+ * reading a regular file can know this without reading ahead:
+ * everything read has been handed out and the file offset is at the
+ * end of the file.
+ * Return: 1 if the input is exhausted, 0 if it is or may not be
+ */
+int input_at_eof(info_t *info)
+{
+	struct stat st;
+	off_t pos;
+
+	if (info->prog)
+		return (info->prog->pc >= info->prog->nlines);
+	if (info->src)
+		return (info->src_pos >= info->src_len);
+	if (interactive(info) || info->read_pending)
+		return (0);
+	if (fstat(info->readfd, &st) == -1 || !S_ISREG(st.st_mode))
+		return (0);
+	pos = lseek(info->readfd, 0, SEEK_CUR);
+	return (pos != -1 && pos >= st.st_size);
+}
+
+/**
+ * tail_exec - runs the final command of the input in place of the shell
+ * @info: the shell state, info->path is the resolved command
+ *
+ * Forking, waiting and exiting with the child's status is the same as
+ * exec'ing the command directly, minus a process. The history is
+ * written first since nothing runs after the exec. Nothing is done
+ * while background jobs are still running, and if execve fails the
+ * caller carries on with the normal fork path and reports the error.
+ */
+void tail_exec(info_t *info)
+{
+	int i;
+
+	for (i = 0; info->jobs && i < JOBS_MAX; i++)
+		if (info->jobs[i].id && info->jobs[i].state != JOB_DONE)
+			return;
+	write_history(info);
+	_putchar(BUF_FLUSH);
+	_eputchar(BUF_FLUSH);
+	execve(info->path, info->argv, get_environ(info));
+}
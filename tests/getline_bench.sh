@@ -0,0 +1,29 @@
+#!/bin/sh
+# Throughput of _getline() on long lines: feeds the shell comment-only
+# lines of 1 KiB, 64 KiB and 1 MiB, about 16 MiB of input per size,
+# from a regular file (block reads) and from a pipe (byte reads).
+#
+# usage: tests/getline_bench.sh [path/to/hsh]
+
+HSH=${1:-./hsh}
+TMP=$(mktemp -d) || exit 1
+trap 'rm -rf "$TMP"' EXIT
+
+for spec in 1024:16384 65536:256 1048576:16; do
+	size=${spec%%:*}
+	count=${spec##*:}
+	awk -v n="$size" -v c="$count" 'BEGIN {
+		line = "#"; while (length(line) < n - 1) line = line line
+		line = substr(line, 1, n - 1)
+		for (i = 0; i < c; i++) print line
+	}' > "$TMP/in"
+	start=$(date +%s.%N)
+	"$HSH" < "$TMP/in" > /dev/null
+	mid=$(date +%s.%N)
+	cat "$TMP/in" | "$HSH" > /dev/null
+	end=$(date +%s.%N)
+	awk -v s="$size" -v c="$count" -v a="$start" -v b="$mid" -v e="$end" \
+		'BEGIN { mb = s * c / 1048576
+		printf "%8d B x %5d  file %6.1f MiB/s  pipe %6.1f MiB/s\n",
+			s, c, mb / (b - a), mb / (e - b) }'
+done
@@ -0,0 +1,79 @@
+#include "shell.h"
+
+/**
+ * cpu_times - reads the CPU time used by the shell and its children
+ * @user: set to the user time in microseconds
+ * @sys: set to the system time in microseconds
+ *
+ * Only children that have been waited for are counted.
+ */
+static void cpu_times(long *user, long *sys)
+{
+	struct rusage self, children;
+
+	getrusage(RUSAGE_SELF, &self);
+	getrusage(RUSAGE_CHILDREN, &children);
+	*user = (self.ru_utime.tv_sec + children.ru_utime.tv_sec) * 1000000L +
+		self.ru_utime.tv_usec + children.ru_utime.tv_usec;
+	*sys = (self.ru_stime.tv_sec + children.ru_stime.tv_sec) * 1000000L +
+		self.ru_stime.tv_usec + children.ru_stime.tv_usec;
+}
+
+/**
+ * time_prefix - starts timing a pipeline run with the time keyword
+ * @info: the shell state structure
+ *
+ * Takes the clock and CPU readings time_report() compares against;
+ * the parser has already taken the keyword off the pipeline.
+ */
+void time_prefix(info_t *info)
+{
+	info->timing.start_us = now_us();
+	cpu_times(&info->timing.user_us, &info->timing.sys_us);
+}
+
+/**
+ * time_report - prints the times of a command run with the time keyword
+ * @info: the shell state structure
+ *
+ * Prints real, user and system time to stderr in the bash layout.
+ */
+void time_report(info_t *info)
+{
+	long user, sys;
+
+	cpu_times(&user, &sys);
+	_eputs("\nreal\t");
+	print_duration(now_us() - info->timing.start_us, STDERR_FILENO);
+	_eputs("\nuser\t");
+	print_duration(user - info->timing.user_us, STDERR_FILENO);
+	_eputs("\nsys\t");
+	print_duration(sys - info->timing.sys_us, STDERR_FILENO);
+	_eputchar('\n');
+}
+
+/**
+ * _mytimes - prints the CPU times of the shell and its children
+ * @info: Structure containing potential arguments. Used to maintain
+ *          constant function prototype.
+ *
+ * Return: Always 0
+ */
+int _mytimes(info_t *info)
+{
+	struct rusage ru;
+	int who;
+
+	(void)info;
+	for (who = 0; who < 2; who++)
+	{
+		getrusage(who ? RUSAGE_CHILDREN : RUSAGE_SELF, &ru);
+		print_duration(ru.ru_utime.tv_sec * 1000000L +
+			ru.ru_utime.tv_usec, STDOUT_FILENO);
+		_putchar(' ');
+		print_duration(ru.ru_stime.tv_sec * 1000000L +
+			ru.ru_stime.tv_usec, STDOUT_FILENO);
+		_putchar('\n');
+	}
+	return (0);
+}
@@ -0,0 +1,112 @@
+#include "shell.h"
+
+/**
+ * var_builtin - runs export, readonly or local
+ * @info: the shell state, whose arguments are options, then NAME or
+ * NAME=value for each variable
+ * @flags: the VAR_ flags the builtin gives
+ * @opts: the options it takes: i to make the variables integers, n to
+ * take @flags away instead of giving them, p to list the variables
+ *
+ * With no names, or with -p, the variables that have @flags are listed.
+ * The status is 1 if a variable could not be declared, 2 on a bad
+ * option.
+ * Return: Always 0
+ */
+static int var_builtin(info_t *info, int flags, char *opts)
+{
+	int i, off = 0, list = 0;
+	char *p;
+
+	info->status = 0;
+	for (i = 1; i < info->argc && info->argv[i][0] == '-' &&
+		info->argv[i][1]; i++)
+	{
+		for (p = info->argv[i] + 1; *p && _strchr(opts, *p); p++)
+		{
+			flags |= *p == 'i' ? VAR_INTEGER : 0;
+			off |= *p == 'n' ? flags & VAR_EXPORT : 0;
+			list |= *p == 'p';
+		}
+		if (*p)
+		{
+			info->status = 2;
+			print_error(info, "Illegal option -");
+			_eputchar(*p);
+			_eputchar('\n');
+			return (0);
+		}
+	}
+	if (list || i == info->argc)
+		var_print(info, flags & ~off & (VAR_EXPORT | VAR_READONLY));
+	for (; i < info->argc; i++)
+		if (var_declare(info, info->argv[i], flags & ~off, off))
+			info->status = 1;
+	return (0);
+}
+
+/**
+ * _myexport - exports variables, so commands get them in their
+ * environment
+ * @info: the shell state, whose arguments are [-inp] [NAME[=value]]...
+ *
+ * export -n takes the variables out of the environment again; they
+ * stay set in the shell.
+ * Return: Always 0
+ */
+int _myexport(info_t *info)
+{
+	return (var_builtin(info, VAR_EXPORT, "inp"));
+}
+
+/**
+ * _myreadonly - makes variables read-only, for as long as the shell runs
+ * @info: the shell state, whose arguments are [-ip] [NAME[=value]]...
+ *
+ * Return: Always 0
+ */
+int _myreadonly(info_t *info)
+{
+	return (var_builtin(info, VAR_READONLY, "ip"));
+}
+
+/**
+ * _mylocal - makes variables local to the { } group being run
+ * @info: the shell state, whose arguments are [-i] [NAME[=value]]...
+ *
+ * The shell has no functions, so a group stands in for one: the
+ * variables get back what they had when the group ends, and inner
+ * groups see the values set in outer ones. local out of a group fails.
+ * Return: Always 0
+ */
+int _mylocal(info_t *info)
+{
+	if (!info->scope)
+	{
+		info->status = 1;
+		print_error(info, "can only be used in a { } group\n");
+		return (0);
+	}
+	return (var_builtin(info, VAR_LOCAL, "i"));
+}
+
+/**
+ * _myunset - unsets variables
+ * @info: the shell state, whose arguments are [-v] NAME...
+ *
+ * The status is 1 if one of the variables is read-only, which is left
+ * as it is; unsetting a variable that is not set is no error.
+ * Return: Always 0
+ */
+int _myunset(info_t *info)
+{
+	int i = 1;
+
+	info->status = 0;
+	if (i < info->argc && !_strcmp(info->argv[i], "-v"))
+		i++;
+	for (; i < info->argc; i++)
+		if (var_unset(info, info->argv[i]) < 0)
+			info->status = 1;
+	return (0);
+}
@@ -0,0 +1,86 @@
+#include "shell.h"
+
+/**
+ * local_save - saves a variable before local changes it
+ * @info: the shell state structure
+ * @name: the name, which need not be null-terminated
+ * @n: the length of the name
+ *
+ * A variable is only saved the first time local changes it in a group,
+ * so what is put back is what it was before the group ran.
+ * Return: 0 on success, -1 if memory ran out
+ */
+int local_save(info_t *info, char *name, size_t n)
+{
+	envvar_t *v = env_find(info, name, n);
+	localvar_t *l;
+
+	for (l = info->locals; l && l->scope == info->scope; l = l->next)
+		if (l->nlen == n && !strncmp(l->str, name, n))
+			return (0);
+	l = malloc(sizeof(localvar_t));
+	if (!l)
+		return (-1);
+	l->str = v ? _strdup(v->str) : malloc(n + 1);
+	if (!l->str)
+		return (free(l), -1);
+	if (!v)
+	{
+		memcpy(l->str, name, n);
+		l->str[n] = 0;
+	}
+	l->nlen = n;
+	l->flags = v ? v->flags : 0;
+	l->scope = info->scope;
+	l->next = info->locals;
+	info->locals = l;
+	return (0);
+}
+
+/**
+ * local_pop - puts back the variables made local in the group ending
+ * @info: the shell state structure, whose scope is left
+ *
+ * Each variable gets back the value and flags it had, read-only ones
+ * too; one that was not set, or cannot be put back for want of memory,
+ * is unset.
+ */
+void local_pop(info_t *info)
+{
+	localvar_t *l;
+	envvar_t *v;
+
+	while ((l = info->locals) && l->scope == info->scope)
+	{
+		info->locals = l->next;
+		if (l->nlen == 4 && !strncmp(l->str, "PATH", 4))
+			cmd_hash_clear(info);
+		v = l->str[l->nlen] ? env_set(info, l->str, l->nlen) : NULL;
+		if (v)
+			env_flags(info, v, l->flags);
+		else
+		{
+			env_unset(info, l->str, l->nlen);
+			free(l->str);
+		}
+		free(l);
+	}
+	info->scope--;
+}
+
+/**
+ * local_free - drops the saved variables without putting them back
+ * @info: the shell state structure
+ */
+void local_free(info_t *info)
+{
+	localvar_t *l;
+
+	while ((l = info->locals))
+	{
+		info->locals = l->next;
+		free(l->str);
+		free(l);
+	}
+	info->scope = 0;
+}
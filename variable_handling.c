@@ -1,168 +1,182 @@
 #include "shell.h"
 
 /**
- * replace_string - substitutes one string for another
- * @old: pointer to the string to be replaced
- * @new: string to replace with
- * This function replaces the contents of the pointer
- * to the old string with a new string
- * and deallocates the memory for the old string.
- * Return: 1 to indicate the operation was successful.
+ * splice_fields - puts the fields in xbuf in place of an argument
+ * @info: the shell state structure
+ * @i: the index of the argument
+ * @keep: on to keep an empty field; an argument that expands to
+ * nothing is otherwise dropped, unless it is the only one
+ *
+ * The fields are the null-separated strings in the first xlen bytes of
+ * xbuf. A single field is one copy into the arena, as before; several
+ * are copied in one go along with a new argv, which points into the
+ * copy.
+ * Return: the index of the last field, i - 1 if the argument was
+ * dropped, -2 if memory ran out
  */
-int replace_string(char **old, char *new)
+static int splice_fields(info_t *info, int i, int keep)
 {
-	free(*old);
-	*old = new;
-	return (1);
+	char **argv, *w;
+	size_t n;
+	int k = info->xlen || keep || info->argc == 1, j;
+
+	for (n = 0; n < info->xlen; n++)
+		k += !info->xbuf[n];
+	if (k == 1)
+		return (replace_arg(info, i, info->xbuf) ? i : -2);
+	argv = arena_alloc(info, sizeof(char *) * (info->argc + k) +
+		info->xlen + 1);
+	if (!argv)
+		return (-2);
+	w = (char *)(argv + info->argc + k);
+	memcpy(w, info->xbuf, info->xlen + 1);
+	for (j = 0; j < i; j++)
+		argv[j] = info->argv[j];
+	for (j = 0; j < k; j++, w += _strlen(w) + 1)
+		argv[i + j] = w;
+	for (j = i + 1; j <= info->argc; j++)
+		argv[j + k - 1] = info->argv[j];
+	info->argv = argv;
+	info->argc += k - 1;
+	return (i + k - 1);
 }
 
 /**
- * is_chain - identifies command separators such as &&, ||, ;
- * @info: context containing shell information
- * @buf: command buffer to be parsed
- * @p: pointer to current position in the buffer
+ * splice_alias - replaces argv[0] with the words of an alias
+ * @info: the shell state structure
+ * @a: the alias
  *
- * Checks for the presence of a chain delimiter in the command
- * buffer and updates the parsing state accordingly.
- * Return: 1 if a delimiter is found, otherwise 0.
+ * The words come from the tokens lexed when the alias was set and go
+ * through expand_text() like the words of the command line do, so
+ * quotes, parameters and command substitutions in the value work. They
+ * are gathered as fields in xbuf and spliced in like the fields of an
+ * expanded word; one that expands to nothing is dropped.
+ * Return: 0 on success, -1 if memory ran out
  */
-int is_chain(info_t *info, char *buf, size_t *p)
+static int splice_alias(info_t *info, alias_t *a)
 {
-	size_t j = *p;
+	char *v = a->node->str + a->nlen + 1;
+	token_t *t = a->toks;
+	int i;
 
-	if (buf[j] == '|' && buf[j + 1] == '|')
-	{
-		buf[j] = 0;
-		j++;
-		info->cmd_buf_type = CMD_OR;
-	}
-	else if (buf[j] == '&' && buf[j + 1] == '&')
-	{
-		buf[j] = 0;
-		j++;
-		info->cmd_buf_type = CMD_AND;
-	}
-	else if (buf[j] == ';') /* found end of this command */
-	{
-		buf[j] = 0; /* replace semicolon with null */
-		info->cmd_buf_type = CMD_CHAIN;
-	}
-	else
-		return (0);
-	*p = j;
-	return (1);
+	info->xlen = 0;
+	for (i = 0; i < a->ntok; i++, t++)
+		if (expand_text(info, v + t->start, v + t->start + t->len, 0) ||
+			(info->xlen && info->xbuf[info->xlen - 1] &&
+			xbuf_put(info, "", 1)))
+			return (-1);
+	if (info->xlen)
+		info->xlen--;
+	if (xbuf_put(info, "", 1))
+		return (-1);
+	info->xlen--;
+	return (splice_fields(info, 0, 0) == -2 ? -1 : 0);
 }
 
 /**
- * check_chain - assesses the need to proceed with command chaining
- * @info: context containing shell information and status
- * @buf: buffer containing the command chain
- * @p: pointer to the current buffer index
- * @i: index in the buffer to check from
- * @len: total length of the buffer
+ * replace_alias - expands an alias at the start of the command
+ * @info: context containing shell information, including aliases
  *
- * This function determines whether to break out of a command chain
- * based on the result of the last command.
- * Return: It modifies the buffer to terminate the chain if necessary.
+ * The first word of an alias is looked up again, so aliases can build
+ * on each other, but an alias is never expanded twice for the same
+ * command, which stops a = b, b = a and ls = ls -F from looping. Each
+ * lookup is a single probe of the alias table. A command name that
+ * was quoted or expanded is never an alias.
+ * Return: 1 if an alias was replaced, 0 otherwise.
  */
-void check_chain(info_t *info, char *buf, size_t *p, size_t i, size_t len)
+int replace_alias(info_t *info)
 {
-	size_t j = *p;
+	alias_t *a;
+	int r = 0;
 
-	if (info->cmd_buf_type == CMD_AND)
+	if (!info->cmd_ntok || info->cmd_toks->flags)
+		return (0);
+	info->alias_gen++;
+	while (info->argc && (a = alias_find(info, info->argv[0],
+		_strlen(info->argv[0]))) && a->gen != info->alias_gen)
 	{
-		if (info->status)
-		{
-			buf[i] = 0;
-			j = len;
-		}
+		a->gen = info->alias_gen;
+		if (splice_alias(info, a) == -1)
+			break;
+		r = 1;
 	}
-	if (info->cmd_buf_type == CMD_OR)
-	{
-		if (!info->status)
-		{
-			buf[i] = 0;
-			j = len;
-		}
-	}
-
-	*p = j;
+	return (r);
 }
 
 /**
- * replace_alias - seeks and replaces aliases in the tokenized command
- * @info: context containing shell information, including aliases
+ * glob_fields - expands the arguments that came from a pattern word
+ * @info: the shell state structure
+ * @i: the index of the first argument the word became
+ * @last: the index of the last one
+ * @t: the word's token
  *
- * Iterates over the aliases list and replaces any matching first
- * argument of the command
- * with its corresponding alias value.
- * Return: 1 if an alias was replaced, 0 otherwise.
+ * A word as written is compiled from the command line, where quotes
+ * keep what they quote literal; the fields of an expanded word are
+ * compiled as they are. A pattern that matches nothing is left alone.
+ * Return: the index of the last argument, -2 if memory ran out
  */
-int replace_alias(info_t *info)
+static int glob_fields(info_t *info, int i, int last, token_t *t)
 {
-	int i;
-	list_t *node;
-	char *p;
+	char *w;
+	int n;
 
-	for (i = 0; i < 10; i++)
+	for (; i <= last; i++)
 	{
-		node = node_starts_with(info->alias, info->argv[0], '=');
-		if (!node)
-			return (0);
-		free(info->argv[0]);
-		p = _strchr(node->str, '=');
-		if (!p)
-			return (0);
-		p = _strdup(p + 1);
-		if (!p)
-			return (0);
-		info->argv[0] = p;
+		w = info->argv[i];
+		if (t->flags & TF_DOLLAR)
+			n = glob_word(info, w, _strlen(w), 0);
+		else
+			n = glob_word(info, info->line + t->start, t->len, 1);
+		if (n == -1)
+			return (-2);
+		if (n > 0)
+		{
+			last += n - 1;
+			i = splice_fields(info, i, 1);
+			if (i == -2)
+				return (-2);
+		}
 	}
-	return (1);
+	return (last);
 }
 
 /**
- * replace_vars - substitutes variables within the command arguments
+ * replace_vars - expands the parameters in the command arguments
  * @info: context containing shell information, including variables
  *
- * Scans through the argument list, replacing any recognized
- * variables with their values.
- * Unrecognized variables are replaced with an empty string.
- * Return:0
+ * Only words the lexer saw a $, a command substitution or an unquoted
+ * wildcard in are looked at. Parameters are expanded in one pass by
+ * expand_word() and the fields spliced in by splice_fields(); a word
+ * that is just $@ becomes one word per positional parameter, and an
+ * unquoted word that expands to nothing is dropped. Pathname patterns
+ * are expanded last, by glob_fields(): words with an unquoted wildcard
+ * and the fields of unquoted expansions. Redirections are skipped;
+ * their words are expanded by redirect().
+ * Return: 0 on success, -1 on an arithmetic error or if memory ran out
  */
 int replace_vars(info_t *info)
 {
-	int i = 0;
-	list_t *node;
+	token_t *t = info->cmd_toks;
+	int i, j, k;
 
-	for (i = 0; info->argv[i]; i++)
+	for (i = 0, j = 0; info->argv[i] && j < info->cmd_ntok; i++, j++)
 	{
-		if (info->argv[i][0] != '$' || !info->argv[i][1])
-			continue;
-
-		if (!_strcmp(info->argv[i], "$?"))
-		{
-			replace_string(&(info->argv[i]),
-				_strdup(convert_number(info->status, 10, 0)));
-			continue;
-		}
-		if (!_strcmp(info->argv[i], "$$"))
-		{
-			replace_string(&(info->argv[i]),
-				_strdup(convert_number(getpid(), 10, 0)));
-			continue;
-		}
-		node = node_starts_with(info->env, &info->argv[i][1], '=');
-		if (node)
+		while (j < info->cmd_ntok && IS_REDIR(t[j].type))
+			j += 2;
+		if (j >= info->cmd_ntok)
+			break;
+		k = i;
+		if ((t[j].flags & TF_DOLLAR) && !replace_param(info, &i))
 		{
-			replace_string(&(info->argv[i]),
-				_strdup(_strchr(node->str, '=') + 1));
-			continue;
+			if (!expand_word(info, info->argv[i]))
+				return (-1);
+			i = splice_fields(info, i, t[j].flags & TF_QUOTED);
 		}
-		replace_string(&info->argv[i], _strdup(""));
-
+		if (i >= k && ((t[j].flags & TF_GLOB) ||
+			(t[j].flags & (TF_DOLLAR | TF_QUOTED)) == TF_DOLLAR))
+			i = glob_fields(info, k, i, t + j);
+		if (i == -2)
+			return (-1);
 	}
 	return (0);
 }
-
-